@@ -114,6 +114,7 @@ for CONFIG_FILE in "${CONFIG_FILES[@]}"; do
 
     LNS_ENABLED=$(awk '$1 == "--heur_lns" { value = $2 } END { print value + 0 }' "$CONFIG_FILE")
     GRASP_ENABLED=$(awk '$1 == "--heur_grasp" { value = $2 } END { print value + 0 }' "$CONFIG_FILE")
+    GRASP_ADAPTIVE=$(awk '$1 == "--grasp_adaptive" { value = $2 } END { print value + 0 }' "$CONFIG_FILE")
     BAD_SOL_ENABLED=$(awk '$1 == "--heur_bad_sol" { value = $2 } END { print value + 0 }' "$CONFIG_FILE")
 
     CONFIG_ARGUMENTS=()
@@ -301,6 +302,11 @@ for CONFIG_FILE in "${CONFIG_FILES[@]}"; do
                         failed_runs=$((failed_runs + 1))
                         continue
                     fi
+
+                    # the adaptive scheduler appends its skipped calls and backoff resets after the name
+                    if [ "$GRASP_ADAPTIVE" -eq 1 ]; then
+                        stats_index=$((stats_index + 2))
+                    fi
                 fi
 
                 config="${FIELDS[$stats_index]:-}"
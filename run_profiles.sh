@@ -0,0 +1,164 @@
+#!/bin/bash
+
+# Benchmark the SCIP settings profiles (settings/*.set) on every instance class
+# and record, for each instance, which profile won.
+# Winner = best primal bound; ties are broken by the smaller gap and then by the
+# smaller total time.
+
+# Exit on error
+set -e
+
+# ============================================
+# CONFIGURATION - Adjust as needed
+# ============================================
+# Base config: heuristics and limits shared by every run (--profile and
+# --param_stamp are appended per profile)
+BASE_CONFIG="${BASE_CONFIG:-./configs/teste_grasp_main.config}"
+
+# Profiles to compare ("legacy" is the hard-coded configuration of configScip)
+PROFILES=(legacy fast-primal tight-bound balanced)
+
+# Instance classes (directories with input*.csv files)
+INPUT_DIRS=(input/easy input/hard input/lns)
+
+# Optional time limit override in seconds (empty = use the base config)
+TIME_LIMIT="${TIME_LIMIT:-}"
+# ============================================
+
+OUTPUT_DIR="output"
+RESULTS_FILE="profiles_benchmark_results.csv"
+WINNERS_FILE="profiles_benchmark_winners.csv"
+SUMMARY_FILE="profiles_benchmark_summary.txt"
+
+if [ ! -f "$BASE_CONFIG" ]; then
+    echo "Error: Config file '$BASE_CONFIG' does not exist."
+    exit 1
+fi
+
+for profile in "${PROFILES[@]}"; do
+    if [ "$profile" != "legacy" ] && [ ! -f "settings/${profile}.set" ]; then
+        echo "Error: Profile 'settings/${profile}.set' does not exist."
+        exit 1
+    fi
+done
+
+# read the base config, dropping options set by this script
+CONFIG_ARGUMENTS=()
+while IFS= read -r config_line || [ -n "$config_line" ]; do
+    if [ -z "$config_line" ] || [[ "$config_line" =~ ^[[:space:]]*# ]]; then
+        continue
+    fi
+    read -ra config_line_arguments <<< "$config_line"
+    case "${config_line_arguments[0]}" in
+        --profile|--param_stamp) continue ;;
+        --time) [ -n "$TIME_LIMIT" ] && continue ;;
+    esac
+    CONFIG_ARGUMENTS+=("${config_line_arguments[@]}")
+done < "$BASE_CONFIG"
+if [ -n "$TIME_LIMIT" ]; then
+    CONFIG_ARGUMENTS+=(--time "$TIME_LIMIT")
+fi
+
+echo "========================================="
+echo "SCIP Settings Profiles Benchmark"
+echo "Started at: $(date)"
+echo "Base config: $BASE_CONFIG"
+echo "Profiles: ${PROFILES[*]}"
+echo "Instance classes: ${INPUT_DIRS[*]}"
+echo "========================================="
+echo ""
+
+echo "Class,Input File,Classes,Professors,Profile,Primal Bound,Dual Bound,Gap,Total Time,Total Nodes,Status" > "$RESULTS_FILE"
+
+for input_dir in "${INPUT_DIRS[@]}"; do
+    if [ ! -d "$input_dir" ]; then
+        echo "Warning: Directory '$input_dir' does not exist. Skipping."
+        continue
+    fi
+    class=$(basename "$input_dir")
+
+    IFS=$'\n' files_to_process=($(ls "$input_dir"/input*.csv 2>/dev/null | sort -V))
+    unset IFS
+
+    for input_file in "${files_to_process[@]}"; do
+        filename=$(basename "$input_file")
+
+        # number of classes and professors from the first line of the input file
+        IFS=';' read -ra HEADER <<< "$(head -n 1 "$input_file")"
+        num_classes="${HEADER[0]}"
+        num_professors="${HEADER[1]}"
+
+        echo "  [$class] $filename (Classes: $num_classes, Professors: $num_professors)"
+
+        for profile in "${PROFILES[@]}"; do
+            stamp="profile_${profile}.config"
+            error_output=$(mktemp)
+            if ! ./bin/dpd "$input_file" "${CONFIG_ARGUMENTS[@]}" --profile "$profile" --param_stamp "$stamp" > /dev/null 2>"$error_output"; then
+                echo "    ✗ $profile: execution failed"
+                head -20 "$error_output" | sed 's/^/      /'
+                rm -f "$error_output"
+                continue
+            fi
+            rm -f "$error_output"
+
+            latest_output=$(ls -td "$OUTPUT_DIR"/*/ | head -1)
+            output_file="${latest_output}${filename}-dpd-${stamp}.out"
+            if [ ! -f "$output_file" ]; then
+                echo "    ✗ $profile: output file not found: $output_file"
+                continue
+            fi
+
+            IFS=';' read -ra FIELDS <<< "$(cat "$output_file")"
+            dual_bound="${FIELDS[3]}"
+            primal_bound="${FIELDS[4]}"
+            gap="${FIELDS[5]}"
+            total_nodes="${FIELDS[7]}"
+            total_time="${FIELDS[10]}"
+            status="${FIELDS[13]}"
+
+            echo "$class,$filename,$num_classes,$num_professors,$profile,$primal_bound,$dual_bound,$gap,$total_time,$total_nodes,$status" >> "$RESULTS_FILE"
+            echo "    ✓ $profile: primal $primal_bound, gap $gap, time ${total_time}s"
+        done
+        echo ""
+    done
+done
+
+# winner per instance: max primal bound, then min gap, then min time
+awk -F',' '
+    NR == 1 { next }
+    {
+        key = $1 "," $2
+        better = !(key in primal)
+        if (!better) {
+            if ($6 + 0 > primal[key]) better = 1
+            else if ($6 + 0 == primal[key] && $8 + 0 < gap[key]) better = 1
+            else if ($6 + 0 == primal[key] && $8 + 0 == gap[key] && $9 + 0 < time[key]) better = 1
+        }
+        if (better) {
+            primal[key] = $6 + 0; gap[key] = $8 + 0; time[key] = $9 + 0
+            winner[key] = $0
+        }
+    }
+    END {
+        print "Class,Input File,Classes,Professors,Winner,Primal Bound,Dual Bound,Gap,Total Time,Total Nodes,Status"
+        for (key in winner) print winner[key]
+    }' "$RESULTS_FILE" | { read -r header; echo "$header"; sort -t',' -k1,1 -k3,3n -k4,4n -k2,2V; } > "$WINNERS_FILE"
+
+{
+    echo "========================================="
+    echo "SCIP SETTINGS PROFILES SUMMARY REPORT"
+    echo "Completed at: $(date)"
+    echo "Base config: $BASE_CONFIG"
+    echo "========================================="
+    echo ""
+    echo "WINS PER PROFILE AND INSTANCE CLASS:"
+    awk -F',' 'NR > 1 { wins[$1 "," $5]++ } END { for (k in wins) { split(k, p, ","); printf "  %-6s %-12s %d\n", p[1], p[2], wins[k] } }' "$WINNERS_FILE" | sort
+    echo ""
+    echo "WINNER PER INSTANCE SIZE (classes x professors):"
+    awk -F',' 'NR > 1 { wins[$3 "x" $4 "," $5]++ } END { for (k in wins) { split(k, p, ","); printf "  %-8s %-12s %d\n", p[1], p[2], wins[k] } }' "$WINNERS_FILE" | sort -V
+    echo ""
+    echo "Per-run results: $RESULTS_FILE"
+    echo "Winner per instance: $WINNERS_FILE"
+} > "$SUMMARY_FILE"
+
+cat "$SUMMARY_FILE"
@@ -0,0 +1,181 @@
+/**@file   batch_dpd.c
+ * @brief  batch mode with a worker pool
+ **/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "batch_dpd.h"
+#include "dpd.h"
+#include "event_interrupt.h"
+
+typedef struct
+{
+  pthread_mutex_t lock;  /**< protects next */
+  int next;              /**< next instance to be solved */
+  int ninstances;        /**< number of instances */
+  BatchResultT *results; /**< one entry per instance */
+  char *program;         /**< program name (used in the output file names) */
+  parametersT param;     /**< parameters of each solve */
+} BatchT;
+
+static void *batchWorker(void *arg)
+{
+  BatchT *batch = (BatchT *) arg;
+  int i;
+
+  for (;;)
+  {
+    pthread_mutex_lock(&batch->lock);
+    i = batch->next++;
+    pthread_mutex_unlock(&batch->lock);
+    // after SIGINT/SIGTERM, the running solves finish and the remaining instances are skipped
+    if (i >= batch->ninstances || getInterruptSignal())
+      break;
+
+    printf("\nBatch: solving %s (%d/%d)\n", batch->results[i].filename, i + 1, batch->ninstances);
+    if (solveInstance(batch->results[i].filename, batch->program, batch->param, &batch->results[i]) != SCIP_OKAY)
+      printf("\nBatch: problem to solve %s\n", batch->results[i].filename);
+  }
+  return NULL;
+}
+
+/** reads the list of instances; returns the number of instances or -1 on error */
+static int readList(char *listfile, BatchResultT **presults)
+{
+  char line[SCIP_MAXSTRLEN];
+  BatchResultT *results;
+  FILE *fin;
+  int n, size;
+  size_t len;
+
+  fin = fopen(listfile, "r");
+  if (!fin)
+  {
+    printf("\nProblem to read batch list %s\n", listfile);
+    return -1;
+  }
+  n       = 0;
+  size    = 64;
+  results = (BatchResultT *) calloc(size, sizeof(BatchResultT));
+  while (results != NULL && fgets(line, sizeof(line), fin) != NULL)
+  {
+    len       = strcspn(line, "\r\n");
+    line[len] = '\0';
+    if (len == 0 || line[0] == '#')
+      continue;
+    if (n == size)
+    {
+      BatchResultT *larger = (BatchResultT *) realloc(results, 2 * size * sizeof(BatchResultT));
+      if (larger == NULL)
+      {
+        free(results);
+        results = NULL;
+        break;
+      }
+      results = larger;
+      memset(results + size, 0, size * sizeof(BatchResultT));
+      size *= 2;
+    }
+    (void) SCIPsnprintf(results[n].filename, SCIP_MAXSTRLEN, "%s", line);
+    n++;
+  }
+  fclose(fin);
+  if (results == NULL)
+  {
+    printf("\nBatch: not enough memory\n");
+    return -1;
+  }
+  *presults = results;
+  return n;
+}
+
+/** writes the aggregate CSV with one line per instance */
+static void writeSummary(BatchT *batch)
+{
+  char filename[SCIP_MAXSTRLEN];
+  FILE *fout;
+  int i;
+
+  (void) SCIPsnprintf(filename, SCIP_MAXSTRLEN, "%s/%s", batch->param.output_path, BATCH_SUMMARY);
+  fout = fopen(filename, "w");
+  if (!fout)
+  {
+    printf("\nProblem to create file %s\n", filename);
+    return;
+  }
+  fprintf(fout, "Input File,Classes,Professors,Solved,Status,Primal Bound,Dual Bound,Gap,Total Time,Total Nodes,Best Sol Found By\n");
+  for (i = 0; i < batch->ninstances; i++)
+  {
+    BatchResultT *r = &batch->results[i];
+    if (r->solved)
+      fprintf(fout, "%s,%d,%d,1,%d,%lf,%lf,%lf,%lf,%lld,%s\n", r->filename, r->nCourses, r->nProfessors, r->status, r->primal, r->dual, r->gap, r->time, r->nodes, r->bestheur);
+    else
+      fprintf(fout, "%s,%d,%d,0,,,,,,,\n", r->filename, r->nCourses, r->nProfessors);
+  }
+  fclose(fout);
+  printf("\nBatch summary written to %s\n", filename);
+}
+
+SCIP_RETCODE runBatch(char *listfile, char *program, parametersT param)
+{
+  BatchT batch;
+  pthread_t *threads;
+  struct timespec start, end;
+  int nthreads, ncreated, i, nsolved;
+
+  batch.ninstances = readList(listfile, &batch.results);
+  if (batch.ninstances < 0)
+    return SCIP_READERROR;
+
+  // each worker solves one instance at a time: --threads is the size of the pool, not a portfolio per instance
+  nthreads            = param.threads < batch.ninstances ? param.threads : batch.ninstances;
+  batch.next          = 0;
+  batch.program       = program;
+  batch.param         = param;
+  batch.param.threads = 1;
+  if (strcmp(batch.param.resume, "none"))
+  {
+    printf("\nResume is ignored in batch mode\n");
+    strcpy(batch.param.resume, "none");
+  }
+  pthread_mutex_init(&batch.lock, NULL);
+
+  threads = (pthread_t *) malloc((nthreads > 0 ? nthreads : 1) * sizeof(pthread_t));
+  if (threads == NULL)
+  {
+    printf("\nBatch: not enough memory\n");
+    free(batch.results);
+    return SCIP_NOMEMORY;
+  }
+
+  printf("\nBatch: %d instances on %d worker threads\n", batch.ninstances, nthreads);
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (ncreated = 0; ncreated < nthreads; ncreated++)
+  {
+    if (pthread_create(&threads[ncreated], NULL, batchWorker, &batch) != 0)
+    {
+      printf("\nBatch: could not create worker thread %d\n", ncreated);
+      break;
+    }
+  }
+  // no thread at all: solve in the main thread
+  if (ncreated == 0)
+    batchWorker(&batch);
+  for (i = 0; i < ncreated; i++)
+    pthread_join(threads[i], NULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  writeSummary(&batch);
+  for (nsolved = 0, i = 0; i < batch.ninstances; i++)
+    nsolved += batch.results[i].solved;
+  printf("Batch: %d of %d instances solved in %.2lfs (wall clock)\n", nsolved, batch.ninstances,
+         (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+
+  pthread_mutex_destroy(&batch.lock);
+  free(threads);
+  free(batch.results);
+  return SCIP_OKAY;
+}
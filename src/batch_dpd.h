@@ -0,0 +1,35 @@
+/**@file   batch_dpd.h
+ * @brief  batch mode: solves the instances of a list file on a pool of worker threads (bin/dpd --batch <list>)
+ **/
+#ifndef __BATCH_DPD__
+#define __BATCH_DPD__
+
+#include "parameters_dpd.h"
+#include "scip/scip.h"
+
+#define BATCH_SUMMARY "batch_summary.csv" /* aggregate CSV written to the output directory */
+
+/** summary of the solve of one instance of the batch */
+typedef struct
+{
+  char filename[SCIP_MAXSTRLEN]; /**< instance file */
+  int nCourses;                  /**< number of courses */
+  int nProfessors;               /**< number of professors */
+  int solved;                    /**< 1 if the solve finished and its outputs were written */
+  SCIP_STATUS status;            /**< SCIP status */
+  SCIP_Real primal;              /**< primal bound */
+  SCIP_Real dual;                /**< dual bound */
+  SCIP_Real gap;                 /**< gap */
+  double time;                   /**< wall clock time of the solve */
+  SCIP_Longint nodes;            /**< number of nodes */
+  char bestheur[64];             /**< heuristic that found the best solution */
+} BatchResultT;
+
+/**
+ * solves each instance listed in listfile (one CSV path per line; blank lines and lines starting with # are skipped)
+ * with param.threads worker threads, each solving one instance at a time with its own SCIP. The .out and .sol files
+ * of each instance are written as in a single run, plus BATCH_SUMMARY with one line per instance.
+ */
+SCIP_RETCODE runBatch(char *listfile, char *program, parametersT param);
+
+#endif
@@ -0,0 +1,178 @@
+/**@file   bench_score.c
+ * @brief  microbenchmark of the GRASP candidate scoring kernels (make bench)
+ *
+ * Times the AVX2 kernel against the scalar kernel on rows of candidates of the lengths found in the instances (the
+ * number of professors of a course ranges from a handful to about 70) and reports the (professor, course) pairs scored
+ * per second. Before timing, the outputs of both kernels are compared on every row: the run fails if a greedy score or
+ * an integer score differs. Usage: bench_score [row length ...]
+ **/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "rng_dpd.h"
+#include "score_dpd.h"
+
+#define BENCH_NROWS 4096      /**< number of rows of each length (the rows are scored in turn, as in a construction) */
+#define BENCH_MINTIME 0.25    /**< each kernel is timed for at least this number of seconds */
+#define BENCH_SEED 20240601u  /**< seed of the generated rows */
+
+/** rows of candidates of the same length */
+typedef struct
+{
+  int count;      /**< number of candidates of each row */
+  double *base;   /**< base preference of each candidate (BENCH_NROWS x count) */
+  double *degp;   /**< degree of the professor of each candidate (BENCH_NROWS x count) */
+  double *degt;   /**< degree of the course of each row */
+  double *greedy; /**< greedy scores (count) */
+  int *score;     /**< integer scores (count) */
+} BenchRowsT;
+
+// wall-clock time in seconds
+static double bench_now(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// rows like those of a construction: preference weights 1..10 (1 for area-based edges), small integer degrees
+static int bench_rows_create(BenchRowsT *rows, int count, RngT *rng)
+{
+  rows->count  = count;
+  rows->base   = (double *) malloc(sizeof(double) * BENCH_NROWS * count);
+  rows->degp   = (double *) malloc(sizeof(double) * BENCH_NROWS * count);
+  rows->degt   = (double *) malloc(sizeof(double) * BENCH_NROWS);
+  rows->greedy = (double *) malloc(sizeof(double) * count);
+  rows->score  = (int *) malloc(sizeof(int) * count);
+  if (rows->base == NULL || rows->degp == NULL || rows->degt == NULL || rows->greedy == NULL || rows->score == NULL)
+    return 0;
+  for (int r = 0; r < BENCH_NROWS; r++)
+  {
+    rows->degt[r] = (double) rngInt(rng, 1, count);
+    for (int i = 0; i < count; i++)
+    {
+      rows->base[r * count + i] = rngUniform(rng) < 0.2 ? 1.0 : (double) rngInt(rng, 1, 10);
+      rows->degp[r * count + i] = (double) rngInt(rng, 0, 20);
+    }
+  }
+  return 1;
+}
+
+static void bench_rows_free(BenchRowsT *rows)
+{
+  free(rows->base);
+  free(rows->degp);
+  free(rows->degt);
+  free(rows->greedy);
+  free(rows->score);
+}
+
+// 1 if both kernels give the same greedy and integer scores on every row
+static int bench_compare(const BenchRowsT *rows, ScoreKernelT a, ScoreKernelT b)
+{
+  int count      = rows->count;
+  double *greedy = (double *) malloc(sizeof(double) * count * 2);
+  int *score     = (int *) malloc(sizeof(int) * count * 2);
+  int same       = greedy != NULL && score != NULL;
+
+  for (int r = 0; r < BENCH_NROWS && same; r++)
+  {
+    a(&rows->base[r * count], &rows->degp[r * count], rows->degt[r], count, greedy, score);
+    b(&rows->base[r * count], &rows->degp[r * count], rows->degt[r], count, greedy + count, score + count);
+    for (int i = 0; i < count && same; i++)
+    {
+      if (memcmp(&greedy[i], &greedy[count + i], sizeof(double)) || score[i] != score[count + i])
+      {
+        printf("row length %d, row %d, candidate %d: greedy %.17g / %.17g, score %d / %d\n", count, r, i, greedy[i],
+               greedy[count + i], score[i], score[count + i]);
+        same = 0;
+      }
+    }
+  }
+  free(greedy);
+  free(score);
+  return same;
+}
+
+// pairs scored per second by a kernel (every row scored in turn, repeated for at least BENCH_MINTIME seconds)
+static double bench_time(BenchRowsT *rows, ScoreKernelT kernel)
+{
+  int count       = rows->count;
+  long long pairs = 0;
+  long long check = 0;
+  double start    = bench_now();
+  double elapsed;
+
+  do
+  {
+    for (int r = 0; r < BENCH_NROWS; r++)
+    {
+      kernel(&rows->base[r * count], &rows->degp[r * count], rows->degt[r], count, rows->greedy, rows->score);
+      check += rows->score[r % count];  // keeps the calls from being optimized away
+    }
+    pairs += (long long) BENCH_NROWS * count;
+    elapsed = bench_now() - start;
+  } while (elapsed < BENCH_MINTIME);
+
+  if (check < 0)
+    printf("unexpected score sum %lld\n", check);
+  return pairs / elapsed;
+}
+
+int main(int argc, char **argv)
+{
+  static const int default_counts[] = {7, 16, 33, 69};
+  int ncounts                        = argc > 1 ? argc - 1 : (int) (sizeof(default_counts) / sizeof(default_counts[0]));
+  int has_avx2                       = 0;
+  int ok                             = 1;
+  RngT rng;
+
+#ifdef GRASP_HAVE_AVX2
+  has_avx2 = __builtin_cpu_supports("avx2");
+#endif
+  if (!has_avx2)
+    printf("AVX2 kernel not available on this build or CPU: only the scalar kernel is timed\n");
+  rngSeed(&rng, BENCH_SEED, 0);
+
+  printf("%8s %16s %16s %8s\n", "row", "scalar pairs/s", "avx2 pairs/s", "speedup");
+  for (int k = 0; k < ncounts && ok; k++)
+  {
+    BenchRowsT rows;
+    double scalar, avx2 = 0.0;
+    int count = argc > 1 ? atoi(argv[k + 1]) : default_counts[k];
+
+    if (count < 1)
+    {
+      printf("invalid row length %s\n", argv[k + 1]);
+      return 1;
+    }
+    if (!bench_rows_create(&rows, count, &rng))
+    {
+      printf("no memory for rows of length %d\n", count);
+      bench_rows_free(&rows);
+      return 1;
+    }
+#ifdef GRASP_HAVE_AVX2
+    if (has_avx2)
+    {
+      ok = bench_compare(&rows, score_kernel_scalar, score_kernel_avx2);
+      if (ok)
+        avx2 = bench_time(&rows, score_kernel_avx2);
+    }
+#endif
+    scalar = bench_time(&rows, score_kernel_scalar);
+    if (has_avx2 && ok)
+      printf("%8d %16.4g %16.4g %7.2fx\n", count, scalar, avx2, avx2 / scalar);
+    else if (ok)
+      printf("%8d %16.4g %16s %8s\n", count, scalar, "-", "-");
+    bench_rows_free(&rows);
+  }
+  if (!ok)
+  {
+    printf("FAILED: the AVX2 and scalar kernels give different scores\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,550 @@
+/**@file   daemon_dpd.c
+ * @brief  daemon mode with a warm cache of built models
+ *
+ * One thread accepts the connections and one thread serves each connection. The cache, the list of running requests
+ * and the list of connections are shared, protected by the mutex of DaemonT; a cached SCIP is used by a single
+ * request at a time (busy flag). If every entry is busy, the request uses a model of its own that is freed afterwards.
+ **/
+#include <assert.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "daemon_dpd.h"
+#include "dpd.h"
+#include "event_incumbent.h"
+#include "event_interrupt.h"
+#include "probdata_dpd.h"
+#include "problem.h"
+
+#define DAEMON_DELIMS " \t\r\n"
+
+/** cached model of one instance */
+typedef struct
+{
+  char filename[SCIP_MAXSTRLEN]; /**< instance file ("" = free entry) */
+  time_t mtime;                  /**< modification time of the file when the model was built */
+  SCIP *scip;                    /**< built model, in problem stage between the solves */
+  int busy;                      /**< 1 while a request solves with this model */
+  long lastuse;                  /**< use counter of the last request (least recently used entry is replaced) */
+} CacheEntryT;
+
+/** running request (target of CANCEL) */
+typedef struct RequestT
+{
+  char id[SCIP_MAXSTRLEN]; /**< id given by the client */
+  volatile int cancel;     /**< set by CANCEL, checked by the interrupt event handler */
+  struct RequestT *next;   /**< next running request */
+} RequestT;
+
+struct DaemonT;
+
+/** open connection */
+typedef struct ConnectionT
+{
+  struct DaemonT *daemon;   /**< daemon data */
+  int fd;                   /**< socket of the connection */
+  FILE *in;                 /**< requests */
+  FILE *out;                /**< replies (on a dup of fd) */
+  struct ConnectionT *next; /**< next open connection */
+} ConnectionT;
+
+/** daemon data */
+typedef struct DaemonT
+{
+  pthread_mutex_t lock;                 /**< protects the fields below */
+  pthread_cond_t closed;                /**< signaled when a connection is closed */
+  parametersT param;                    /**< parameters of every solve */
+  CacheEntryT cache[DAEMON_CACHE_SIZE]; /**< cached models */
+  long nuses;                           /**< use counter */
+  RequestT *running;                    /**< running requests */
+  ConnectionT *connections;             /**< open connections */
+} DaemonT;
+
+/** builds the model of an instance: SCIP with all plugins and the problem loaded */
+static SCIP_RETCODE buildModel(DaemonT *daemon, char *filename, SCIP **pscip)
+{
+  parametersT param;
+  Instance *in;
+
+  param = daemon->param;
+  if (!loadInstance(filename, &in, param.area_penalty))
+    return SCIP_READERROR;
+  selectProfile(&param, in);
+  SCIP_CALL(configScip(pscip, &param));
+  SCIP_CALL(SCIPsetIntParam(*pscip, "display/verblevel", 0));
+  if (!loadProblem(*pscip, filename, in, 0, NULL))
+  {
+    SCIP_CALL(SCIPfree(pscip));
+    return SCIP_ERROR;
+  }
+  // incumbents are streamed to the connection of each request
+  SCIP_CALL(SCIPincludeEventHdlrIncumbent(*pscip, ""));
+
+  return SCIP_OKAY;
+}
+
+/**
+ * gets a model of the instance for a request: the cached one if it is up to date and free, or a new one (stored in
+ * the cache if there is a free or unused entry). slot = -1 if the model is not cached.
+ */
+static SCIP_RETCODE acquireModel(DaemonT *daemon, char *filename, SCIP **pscip, int *slot, int *cached)
+{
+  struct stat st;
+  SCIP *stale, *evicted;
+  int i, best;
+
+  *pscip  = NULL;
+  *slot   = -1;
+  *cached = 0;
+  if (stat(filename, &st))
+    return SCIP_NOFILE;
+
+  stale   = NULL;
+  pthread_mutex_lock(&daemon->lock);
+  for (i = 0; i < DAEMON_CACHE_SIZE; i++)
+  {
+    CacheEntryT *entry = &daemon->cache[i];
+    if (entry->busy || strcmp(entry->filename, filename))
+      continue;
+    if (entry->mtime == st.st_mtime)
+    {
+      entry->busy    = 1;
+      entry->lastuse = ++daemon->nuses;
+      *pscip         = entry->scip;
+      *slot          = i;
+      *cached        = 1;
+      break;
+    }
+    // the file changed: rebuild the model
+    stale            = entry->scip;
+    entry->scip      = NULL;
+    *entry->filename = '\0';
+    break;
+  }
+  pthread_mutex_unlock(&daemon->lock);
+  if (stale != NULL)
+    SCIP_CALL(SCIPfree(&stale));
+  if (*cached)
+    return SCIP_OKAY;
+
+  SCIP_CALL(buildModel(daemon, filename, pscip));
+
+  evicted = NULL;
+  pthread_mutex_lock(&daemon->lock);
+  best = -1;
+  for (i = 0; i < DAEMON_CACHE_SIZE; i++)
+  {
+    CacheEntryT *entry = &daemon->cache[i];
+    if (entry->busy)
+      continue;
+    if (entry->scip == NULL)
+    {
+      best = i;
+      break;
+    }
+    if (best < 0 || entry->lastuse < daemon->cache[best].lastuse)
+      best = i;
+  }
+  if (best >= 0)
+  {
+    CacheEntryT *entry = &daemon->cache[best];
+    evicted            = entry->scip;
+    entry->scip        = *pscip;
+    entry->mtime       = st.st_mtime;
+    entry->busy        = 1;
+    entry->lastuse     = ++daemon->nuses;
+    (void) SCIPsnprintf(entry->filename, SCIP_MAXSTRLEN, "%s", filename);
+    *slot = best;
+  }
+  pthread_mutex_unlock(&daemon->lock);
+  if (evicted != NULL)
+    SCIP_CALL(SCIPfree(&evicted));
+
+  return SCIP_OKAY;
+}
+
+/** gives the model back to the cache; a model that is not cached or not reusable (failed solve) is freed */
+static void releaseModel(DaemonT *daemon, SCIP *scip, int slot, int reusable)
+{
+  if (slot >= 0)
+  {
+    pthread_mutex_lock(&daemon->lock);
+    daemon->cache[slot].busy = 0;
+    if (!reusable)
+    {
+      daemon->cache[slot].scip      = NULL;
+      *daemon->cache[slot].filename = '\0';
+    }
+    pthread_mutex_unlock(&daemon->lock);
+  }
+  if (slot < 0 || !reusable)
+    SCIPfree(&scip);
+}
+
+/** registers a running request; returns NULL if a request with this id is already running */
+static RequestT *addRequest(DaemonT *daemon, const char *id)
+{
+  RequestT *req;
+
+  pthread_mutex_lock(&daemon->lock);
+  for (req = daemon->running; req != NULL && strcmp(req->id, id); req = req->next);
+  if (req != NULL)
+  {
+    pthread_mutex_unlock(&daemon->lock);
+    return NULL;
+  }
+  req = (RequestT *) malloc(sizeof(RequestT));
+  if (req != NULL)
+  {
+    (void) SCIPsnprintf(req->id, SCIP_MAXSTRLEN, "%s", id);
+    req->cancel     = 0;
+    req->next       = daemon->running;
+    daemon->running = req;
+  }
+  pthread_mutex_unlock(&daemon->lock);
+  return req;
+}
+
+/** unregisters a finished request */
+static void removeRequest(DaemonT *daemon, RequestT *req)
+{
+  RequestT **p;
+
+  pthread_mutex_lock(&daemon->lock);
+  for (p = &daemon->running; *p != NULL && *p != req; p = &(*p)->next);
+  if (*p != NULL)
+    *p = req->next;
+  pthread_mutex_unlock(&daemon->lock);
+  free(req);
+}
+
+/** asks a running request to stop; returns 0 if there is no running request with this id */
+static int cancelRequest(DaemonT *daemon, const char *id)
+{
+  RequestT *req;
+
+  pthread_mutex_lock(&daemon->lock);
+  for (req = daemon->running; req != NULL && strcmp(req->id, id); req = req->next);
+  if (req != NULL)
+    req->cancel = 1;
+  pthread_mutex_unlock(&daemon->lock);
+  return req != NULL;
+}
+
+/**
+ * solves the model with the limits and bound changes of a request, streams its incumbents and writes its RESULT.
+ * The model is back in problem stage, with its original bounds, on return.
+ */
+static SCIP_RETCODE solveModel(SCIP *scip, FILE *out, RequestT *req, int nfix, int *fixprof, int *fixcourse, int *fixvalue,
+                               double timelimit, SCIP_Longint nodes)
+{
+  SCIP_PROBDATA *probdata;
+  SCIP_SOL *bestSolution;
+  SCIP_VAR *var;
+  Instance *I;
+  struct timespec wallstart, wallend;
+  char tag[SCIP_MAXSTRLEN];
+  int *assignment;
+  int i, j;
+
+  probdata = SCIPgetProbData(scip);
+  I        = SCIPprobdataGetInstance(probdata);
+
+  // what-if: bounds of this request only (the original bounds are restored below)
+  for (i = 0; i < nfix; i++)
+  {
+    var = SCIPprobdataGetVarByIndex(probdata, fixprof[i], fixcourse[i]);
+    if (fixvalue[i])
+      SCIP_CALL(SCIPchgVarLb(scip, var, 1.0));
+    else
+      SCIP_CALL(SCIPchgVarUb(scip, var, 0.0));
+  }
+  SCIP_CALL(SCIPsetRealParam(scip, "limits/time", timelimit));
+  SCIP_CALL(SCIPsetLongintParam(scip, "limits/nodes", nodes));
+  (void) SCIPsnprintf(tag, SCIP_MAXSTRLEN, "INCUMBENT %s", req->id);
+  SCIP_CALL(SCIPsetIncumbentStream(scip, out, tag));
+  SCIP_CALL(SCIPsetInterruptCancelFlag(scip, &req->cancel));
+
+  clock_gettime(CLOCK_MONOTONIC, &wallstart);
+  SCIP_CALL(SCIPsolve(scip));
+  clock_gettime(CLOCK_MONOTONIC, &wallend);
+
+  fprintf(out, "RESULT %s %d %lf %lf %lf %.3lf", req->id, SCIPgetStatus(scip), SCIPgetPrimalbound(scip), SCIPgetDualbound(scip), SCIPgetGap(scip),
+          (wallend.tv_sec - wallstart.tv_sec) + (wallend.tv_nsec - wallstart.tv_nsec) / 1e9);
+  bestSolution = SCIPgetBestSol(scip);
+  assignment   = (int *) malloc(sizeof(int) * I->nCourses);
+  if (bestSolution != NULL && assignment != NULL && SCIPprobdataGetAssignment(scip, SCIPgetProbData(scip), bestSolution, assignment))
+  {
+    for (j = 0; j < I->nCourses; j++)
+      fprintf(out, " %d", assignment[j] + 1);
+  }
+  fprintf(out, "\n");
+  fflush(out);
+  free(assignment);
+
+  // back to the original problem, ready for the next request
+  SCIP_CALL(SCIPsetIncumbentStream(scip, NULL, NULL));
+  SCIP_CALL(SCIPsetInterruptCancelFlag(scip, NULL));
+  SCIP_CALL(SCIPfreeTransform(scip));
+  for (i = 0; i < nfix; i++)
+  {
+    var = SCIPprobdataGetVarByIndex(probdata, fixprof[i], fixcourse[i]);
+    if (fixvalue[i])
+      SCIP_CALL(SCIPchgVarLb(scip, var, 0.0));
+    else
+      SCIP_CALL(SCIPchgVarUb(scip, var, 1.0));
+  }
+
+  return SCIP_OKAY;
+}
+
+/** serves a SOLVE or WHATIF request; the tokens after the kind of request are read from save */
+static void serveSolve(DaemonT *daemon, FILE *out, const char *kind, char **save)
+{
+  char *id, *filename, *option, *value, *value2;
+  int *fixprof, *fixcourse, *fixvalue;
+  int nfix, slot, cached, i;
+  double timelimit;
+  SCIP_Longint nodes;
+  SCIP_RETCODE retcode;
+  RequestT *req;
+  Instance *I;
+  SCIP *scip;
+
+  id       = strtok_r(NULL, DAEMON_DELIMS, save);
+  filename = id != NULL ? strtok_r(NULL, DAEMON_DELIMS, save) : NULL;
+  if (filename == NULL)
+  {
+    fprintf(out, "ERROR %s missing %s\n", id != NULL ? id : "-", id != NULL ? "instance" : "id");
+    return;
+  }
+
+  // options (a request line has less than DAEMON_MAXLINE / 2 tokens)
+  fixprof   = (int *) malloc(sizeof(int) * DAEMON_MAXLINE / 2);
+  fixcourse = (int *) malloc(sizeof(int) * DAEMON_MAXLINE / 2);
+  fixvalue  = (int *) malloc(sizeof(int) * DAEMON_MAXLINE / 2);
+  if (fixprof == NULL || fixcourse == NULL || fixvalue == NULL)
+  {
+    fprintf(out, "ERROR %s out of memory\n", id);
+    free(fixprof);
+    free(fixcourse);
+    free(fixvalue);
+    return;
+  }
+  nfix      = 0;
+  timelimit = daemon->param.time_limit;
+  nodes     = daemon->param.nodes_limit;
+  while ((option = strtok_r(NULL, DAEMON_DELIMS, save)) != NULL)
+  {
+    value = strtok_r(NULL, DAEMON_DELIMS, save);
+    if (value != NULL && !strcmp(option, "--time") && atof(value) > 0)
+      timelimit = atof(value);
+    else if (value != NULL && !strcmp(option, "--nodes") && atoll(value) >= -1)
+      nodes = atoll(value);
+    else if (value != NULL && (!strcmp(option, "--fix") || !strcmp(option, "--forbid")) && !strcmp(kind, "WHATIF") &&
+             (value2 = strtok_r(NULL, DAEMON_DELIMS, save)) != NULL)
+    {
+      fixprof[nfix]   = atoi(value) - 1;
+      fixcourse[nfix] = atoi(value2) - 1;
+      fixvalue[nfix]  = !strcmp(option, "--fix");
+      nfix++;
+    }
+    else
+    {
+      fprintf(out, "ERROR %s invalid option %s\n", id, option);
+      nfix = -1;
+      break;
+    }
+  }
+
+  req = nfix >= 0 ? addRequest(daemon, id) : NULL;
+  if (nfix >= 0 && req == NULL)
+    fprintf(out, "ERROR %s request already running\n", id);
+  if (req != NULL)
+  {
+    retcode = acquireModel(daemon, filename, &scip, &slot, &cached);
+    if (retcode != SCIP_OKAY)
+      fprintf(out, "ERROR %s problem to load instance %s\n", id, filename);
+    else
+    {
+      fprintf(out, "ACCEPTED %s %s\n", id, cached ? "cached" : "loaded");
+      fflush(out);
+      I = SCIPprobdataGetInstance(SCIPgetProbData(scip));
+      for (i = 0; i < nfix && fixprof[i] >= 0 && fixprof[i] < I->nProfessors && fixcourse[i] >= 0 && fixcourse[i] < I->nCourses; i++);
+      if (i < nfix)
+      {
+        fprintf(out, "ERROR %s invalid professor or course (%d %d)\n", id, fixprof[i] + 1, fixcourse[i] + 1);
+        releaseModel(daemon, scip, slot, 1);
+      }
+      else
+      {
+        retcode = solveModel(scip, out, req, nfix, fixprof, fixcourse, fixvalue, timelimit, nodes);
+        if (retcode != SCIP_OKAY)
+          fprintf(out, "ERROR %s solve failed (SCIP error %d)\n", id, retcode);
+        releaseModel(daemon, scip, slot, retcode == SCIP_OKAY);
+      }
+    }
+    removeRequest(daemon, req);
+  }
+  free(fixprof);
+  free(fixcourse);
+  free(fixvalue);
+}
+
+/** unlinks a connection and closes its socket */
+static void closeConnection(DaemonT *daemon, ConnectionT *conn)
+{
+  ConnectionT **p;
+
+  pthread_mutex_lock(&daemon->lock);
+  for (p = &daemon->connections; *p != NULL && *p != conn; p = &(*p)->next);
+  if (*p != NULL)
+    *p = conn->next;
+  if (conn->in != NULL)
+    fclose(conn->in);
+  else
+    close(conn->fd);
+  if (conn->out != NULL)
+    fclose(conn->out);
+  pthread_cond_signal(&daemon->closed);
+  pthread_mutex_unlock(&daemon->lock);
+  free(conn);
+}
+
+/** serves the requests of one connection, one at a time */
+static void *connectionThread(void *arg)
+{
+  ConnectionT *conn = (ConnectionT *) arg;
+  DaemonT *daemon   = conn->daemon;
+  char line[DAEMON_MAXLINE];
+  char *kind, *id, *save;
+  int outfd;
+
+  conn->in  = fdopen(conn->fd, "r");
+  outfd     = dup(conn->fd);
+  conn->out = outfd >= 0 ? fdopen(outfd, "w") : NULL;
+  if (conn->out == NULL && outfd >= 0)
+    close(outfd);
+
+  while (conn->in != NULL && conn->out != NULL && fgets(line, sizeof(line), conn->in) != NULL)
+  {
+    kind = strtok_r(line, DAEMON_DELIMS, &save);
+    if (kind == NULL)
+      continue;
+    if (!strcmp(kind, "SOLVE") || !strcmp(kind, "WHATIF"))
+      serveSolve(daemon, conn->out, kind, &save);
+    else if (!strcmp(kind, "CANCEL"))
+    {
+      id = strtok_r(NULL, DAEMON_DELIMS, &save);
+      if (id == NULL)
+        fprintf(conn->out, "ERROR - missing id\n");
+      else if (cancelRequest(daemon, id))
+        fprintf(conn->out, "CANCELED %s\n", id);
+      else
+        fprintf(conn->out, "ERROR %s no running request\n", id);
+    }
+    else if (!strcmp(kind, "QUIT"))
+      break;
+    else
+      fprintf(conn->out, "ERROR - unknown request %s\n", kind);
+    fflush(conn->out);
+  }
+  closeConnection(daemon, conn);
+  return NULL;
+}
+
+/** listens on the Unix domain socket and serves solve requests until SIGINT/SIGTERM */
+SCIP_RETCODE runDaemon(char *socketpath, parametersT param)
+{
+  struct sockaddr_un addr;
+  struct pollfd pfd;
+  pthread_t thread;
+  ConnectionT *conn;
+  DaemonT daemon;
+  int listenfd, fd, i;
+
+  if (strlen(socketpath) >= sizeof(addr.sun_path))
+  {
+    printf("\nSocket path too long: %s\n", socketpath);
+    return SCIP_INVALIDDATA;
+  }
+  memset(&daemon, 0, sizeof(daemon));
+  daemon.param = param;
+  pthread_mutex_init(&daemon.lock, NULL);
+  pthread_cond_init(&daemon.closed, NULL);
+
+  // a client that disconnects during a reply must not stop the daemon
+  signal(SIGPIPE, SIG_IGN);
+
+  listenfd = socket(AF_UNIX, SOCK_STREAM, 0);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, socketpath);
+  unlink(socketpath);
+  if (listenfd < 0 || bind(listenfd, (struct sockaddr *) &addr, sizeof(addr)) || listen(listenfd, 16))
+  {
+    printf("\nProblem to listen on %s\n", socketpath);
+    if (listenfd >= 0)
+      close(listenfd);
+    return SCIP_ERROR;
+  }
+  printf("\nDaemon listening on %s (cache of %d instances)\n", socketpath, DAEMON_CACHE_SIZE);
+  fflush(stdout);
+
+  pfd.fd     = listenfd;
+  pfd.events = POLLIN;
+  while (!getInterruptSignal())
+  {
+    if (poll(&pfd, 1, DAEMON_POLL_MS) <= 0)
+      continue;
+    fd = accept(listenfd, NULL, NULL);
+    if (fd < 0)
+      continue;
+    conn = (ConnectionT *) calloc(1, sizeof(ConnectionT));
+    if (conn == NULL)
+    {
+      close(fd);
+      continue;
+    }
+    conn->daemon = &daemon;
+    conn->fd     = fd;
+    pthread_mutex_lock(&daemon.lock);
+    conn->next         = daemon.connections;
+    daemon.connections = conn;
+    pthread_mutex_unlock(&daemon.lock);
+    if (pthread_create(&thread, NULL, connectionThread, conn))
+      closeConnection(&daemon, conn);
+    else
+      pthread_detach(thread);
+  }
+  close(listenfd);
+  unlink(socketpath);
+
+  // running solves are stopped by the interrupt event handler; idle connections are woken up here
+  printf("\nDaemon stopping (signal %d)\n", getInterruptSignal());
+  pthread_mutex_lock(&daemon.lock);
+  for (conn = daemon.connections; conn != NULL; conn = conn->next)
+    shutdown(conn->fd, SHUT_RDWR);
+  while (daemon.connections != NULL)
+    pthread_cond_wait(&daemon.closed, &daemon.lock);
+  pthread_mutex_unlock(&daemon.lock);
+
+  for (i = 0; i < DAEMON_CACHE_SIZE; i++)
+  {
+    if (daemon.cache[i].scip != NULL)
+      SCIP_CALL(SCIPfree(&daemon.cache[i].scip));
+  }
+  pthread_cond_destroy(&daemon.closed);
+  pthread_mutex_destroy(&daemon.lock);
+
+  return SCIP_OKAY;
+}
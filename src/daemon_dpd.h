@@ -0,0 +1,41 @@
+/**@file   daemon_dpd.h
+ * @brief  daemon mode: long-running solver on a Unix domain socket (bin/dpd --daemon <socket>)
+ *
+ * The daemon keeps the last DAEMON_CACHE_SIZE instances with their built models (a SCIP in problem stage, with all
+ * plugins included), so a repeated instance is solved without parsing, model building and plugin setup. A cached
+ * model is reused while its file is not modified; after each solve, SCIPfreeTransform() brings it back to the
+ * original problem.
+ *
+ * Each connection is served by its own thread and handles one request at a time. Requests are text lines:
+ *   SOLVE <id> <instance> [--time <s>] [--nodes <n>]
+ *   WHATIF <id> <instance> [--fix <prof> <course>]... [--forbid <prof> <course>]... [--time <s>] [--nodes <n>]
+ *   CANCEL <id>
+ *   QUIT
+ * <id> is chosen by the client; professors and courses are numbered from 1, as in the .sol file. --fix and --forbid
+ * only change the bounds for this request. The other parameters are the ones given on the command line.
+ * Replies are text lines, starting with the kind of reply and the id of the request:
+ *   ACCEPTED <id> cached|loaded
+ *   INCUMBENT <id> <solving time> <objective> <heuristic> <professor of course 1> ... <professor of course n>
+ *   RESULT <id> <status> <primal> <dual> <gap> <time> <professor of course 1> ... <professor of course n>
+ *   CANCELED <id>
+ *   ERROR <id> <message>
+ * RESULT lists no professors if no solution was found. CANCEL makes the solve stop as soon as possible; its RESULT
+ * is still sent to the connection of the request.
+ **/
+#ifndef __DAEMON_DPD__
+#define __DAEMON_DPD__
+
+#include "parameters_dpd.h"
+#include "scip/scip.h"
+
+#define DAEMON_CACHE_SIZE 8    /* number of instances (with their built models) kept in memory */
+#define DAEMON_MAXLINE 4096    /* maximal length of a request line */
+#define DAEMON_POLL_MS 500     /* interval to check for SIGINT/SIGTERM while waiting for connections */
+
+/**
+ * listens on the Unix domain socket socketpath and serves solve requests until SIGINT/SIGTERM. param holds the
+ * parameters of every solve (the time and node limits can be changed by each request).
+ */
+SCIP_RETCODE runDaemon(char *socketpath, parametersT param);
+
+#endif
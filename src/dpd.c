@@ -0,0 +1,701 @@
+/**@file   dpd.c
+ * @brief  libdpd: solve of one instance (shared by the command line program and the batch mode) and the handle API
+ **/
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+
+#include "dpd.h"
+#include "event_checkpoint.h"
+#include "event_incumbent.h"
+#include "event_interrupt.h"
+#include "heur_badFeasible.h"
+#include "heur_grasp.h"
+#include "heur_lns.h"
+#include "portfolio_dpd.h"
+#include "probdata_dpd.h"
+#include "scip/scipdefplugins.h"
+
+/** solver handle */
+struct DPD_Context
+{
+  parametersT param;             /**< parameters of the solves */
+  char filename[SCIP_MAXSTRLEN]; /**< instance file */
+  Instance *in;                  /**< loaded instance; NULL after a solve (the instance belongs to the SCIP of the solve) */
+  int nCourses;                  /**< number of courses */
+  int nProfessors;               /**< number of professors */
+  int *assignment;               /**< professor of each course in the best solution of the last solve */
+  int hassol;                    /**< 1 if the last solve found a solution */
+  SCIP_STATUS status;            /**< SCIP status of the last solve */
+  SCIP_Real primal;              /**< primal bound of the last solve */
+  SCIP_Real dual;                /**< dual bound of the last solve */
+  SCIP_Real gap;                 /**< gap of the last solve */
+  double time;                   /**< wall clock time of the last solve */
+};
+
+SCIP_RETCODE printStatistic(SCIP *scip, double time, char *outputname, const parametersT *param)
+{
+  SCIP_Bool outputorigsol = TRUE;
+  SCIP_SOL *bestSolution  = NULL;
+  char filename[SCIP_MAXSTRLEN];
+  FILE *fout;
+  SCIP_HEUR *heur_hdlr;
+
+  // Use output_path for output file location
+  sprintf(filename, "%s/%s.out", param->output_path, outputname);
+  fout = fopen(filename, "w");
+  if (!fout)
+  {
+    printf("\nProblem to create file %s\n", filename);
+    return 1;
+  }
+
+  /* I found the commands for those statistical information looking the scip source code at file scip.c (printPricerStatistics(), for instance)  */
+  bestSolution = SCIPgetBestSol(scip);
+  if (outputorigsol)
+  {
+    if (bestSolution == NULL)
+      printf("\nno solution available\n");
+    else
+    {
+      SCIP_SOL *origsol;
+      SCIP_CALL(SCIPcreateSolCopy(scip, &origsol, bestSolution));
+      SCIP_CALL(SCIPretransformSol(scip, origsol));
+      SCIP_CALL(SCIPprintSol(scip, origsol, NULL, FALSE));
+      SCIP_CALL(SCIPfreeSol(scip, &origsol));
+    }
+  }
+  else
+  {
+    SCIP_CALL(SCIPprintBestSol(scip, NULL, FALSE));
+  }
+  SCIPinfoMessage(scip, NULL, "\nStatistics\n");
+  SCIPinfoMessage(scip, NULL, "==========\n\n");
+  SCIP_CALL(SCIPprintStatistics(scip, NULL));
+  if (fout != NULL)
+  {
+    fprintf(fout, "%s;%lli;%lf;%lf;%lf;%lf;%lf;%lli;%d;%lf;%lf;%lli;%d;%d", SCIPgetProbName(scip), SCIPgetNRootLPIterations(scip), time, SCIPgetDualbound(scip), SCIPgetPrimalbound(scip), SCIPgetGap(scip), SCIPgetDualboundRoot(scip), SCIPgetNTotalNodes(scip), SCIPgetNNodesLeft(scip), SCIPgetSolvingTime(scip), SCIPgetTotalTime(scip), SCIPgetMemUsed(scip), SCIPgetNLPCols(scip), SCIPgetStatus(scip));
+    if (bestSolution != NULL)
+    {
+      fprintf(fout, ";bestsol in %lld;%lf;%d;%s", SCIPsolGetNodenum(bestSolution), SCIPsolGetTime(bestSolution), SCIPsolGetDepth(bestSolution), SCIPsolGetHeur(bestSolution) != NULL ? SCIPheurGetName(SCIPsolGetHeur(bestSolution)) : (SCIPsolGetRunnum(bestSolution) == 0 ? "initial" : "relaxation"));
+    }
+    if (param->heur_lns)
+    {
+      heur_hdlr = SCIPfindHeur(scip, "lns");
+      fprintf(fout, ";%lf;%lld;%lld;%lld;%lld;%s", SCIPheurGetTime(heur_hdlr), SCIPheurGetNCalls(heur_hdlr), SCIPheurLnsGetNExecutions(heur_hdlr), SCIPheurGetNSolsFound(heur_hdlr), SCIPheurGetNBestSolsFound(heur_hdlr), SCIPheurGetName(heur_hdlr));
+    }
+    if (param->heur_bad_sol)
+    {
+      heur_hdlr = SCIPfindHeur(scip, "badFeasibleSolution");
+      fprintf(fout, ";%lf;%lld;%lld;%lld;%s", SCIPheurGetTime(heur_hdlr), SCIPheurGetNCalls(heur_hdlr), SCIPheurGetNSolsFound(heur_hdlr), SCIPheurGetNBestSolsFound(heur_hdlr), SCIPheurGetName(heur_hdlr));
+    }
+    if (param->heur_grasp)
+    {
+      heur_hdlr = SCIPfindHeur(scip, "grasp");
+      fprintf(fout, ";%lf;%lld;%lld;%lld;%s", SCIPheurGetTime(heur_hdlr), SCIPheurGetNCalls(heur_hdlr), SCIPheurGetNSolsFound(heur_hdlr), SCIPheurGetNBestSolsFound(heur_hdlr), SCIPheurGetName(heur_hdlr));
+      // the counters of the adaptive scheduler follow the name, so the GRASP block keeps its layout without it
+      if (param->grasp_adaptive)
+        fprintf(fout, ";%lld;%lld", SCIPheurGraspGetNSkipped(heur_hdlr), SCIPheurGraspGetNResets(heur_hdlr));
+    }
+
+    fprintf(fout, ";%s\n", param->parameter_stamp);
+  }
+  fclose(fout);
+  return SCIP_OKAY;
+}
+
+/** 
+ * creates a SCIP instance with default plugins, and set SCIP parameters 
+ */
+SCIP_RETCODE configScip(
+        SCIP **pscip,
+        const parametersT *param)
+{
+
+  SCIP *scip           = NULL;
+  char settings[SCIP_MAXSTRLEN];
+  /* initialize SCIP */
+  SCIP_RETCODE retcode = SCIPcreate(&scip);
+  if (retcode != SCIP_OKAY || scip == NULL)
+  {
+    printf("SCIPcreate failed: retcode=%d, scip=%p\n", retcode, (void *) scip);
+    return 1;
+  }
+
+  /* include default SCIP plugins */
+  SCIP_CALL(SCIPincludeDefaultPlugins(scip));
+  /* SIGINT/SIGTERM are handled by the interrupt event handler (also in sub-SCIPs and portfolio workers) */
+  SCIP_CALL(SCIPsetBoolParam(scip, "misc/catchctrlc", FALSE));
+  SCIP_CALL(SCIPincludeEventHdlrInterrupt(scip));
+  if (!strcmp(param->profile, "legacy") || !strcmp(param->profile, "auto"))
+  {
+    /* for column generation, disable restarts */
+    SCIP_CALL(SCIPsetIntParam(scip, "presolving/maxrestarts", 0));
+    /* disable presolving */
+    SCIP_CALL(SCIPsetPresolving(scip, SCIP_PARAMSETTING_OFF, TRUE));  // turn off
+    /* turn off all separation algorithms */
+    SCIP_CALL(SCIPsetSeparating(scip, SCIP_PARAMSETTING_OFF, TRUE));  // turn off
+    /* disable heuristics */
+    SCIP_CALL(SCIPsetHeuristics(scip, SCIP_PARAMSETTING_OFF, TRUE));  // turn off
+    /* for column generation, usualy we prefer branching using pscost instead of relcost  */
+    SCIP_CALL(SCIPsetIntParam(scip, "branching/pscost/priority", 1000000));
+  }
+  else
+  {
+    /* SCIP primal heuristics start turned off, so a profile runs exactly the ones its file enables */
+    SCIP_CALL(SCIPsetHeuristics(scip, SCIP_PARAMSETTING_OFF, TRUE));
+    /* read the settings profile; the parameters below always override it */
+    (void) SCIPsnprintf(settings, SCIP_MAXSTRLEN, "%s/%s.set", PROFILE_DIR, param->profile);
+    SCIP_CALL(SCIPreadParams(scip, settings));
+  }
+
+  SCIP_CALL(SCIPsetIntParam(scip, "display/freq", param->display_freq));
+  SCIP_CALL(SCIPsetIntParam(scip, "randomization/randomseedshift", param->seed));
+  /* set time limit */
+  SCIP_CALL(SCIPsetRealParam(scip, "limits/time", param->time_limit));
+  // for only root, use 1
+  SCIP_CALL(SCIPsetLongintParam(scip, "limits/nodes", param->nodes_limit));
+
+  // active heuristic of rounding
+  if (param->heur_bad_sol)
+    SCIP_CALL(SCIPincludeHeurBadFeasibleSolution(scip));
+  if (param->heur_lns)
+    SCIP_CALL(SCIPincludeHeurLns(scip, param));
+  if (param->heur_grasp)
+    SCIP_CALL(SCIPincludeHeurGrasp(scip, param));
+
+  *pscip = scip;
+
+  return SCIP_OKAY;
+}
+/**
+ * resolve profile "auto" into a settings profile according to the instance size. The threshold comes from the recorded
+ * runs of LNS|GRASP/all (42 instances of 62 to 224 courses, 400 s): up to 125 courses, runs without primal heuristics
+ * had the lowest shifted geometric mean time (25.8 s against 39.8 s with LNS); above 125 courses, runs with LNS did
+ * better (65.9 s against 71.5 s, 4 instances left open against 5). Runs mixing GRASP and LNS won no size range, so
+ * "auto" never picks "balanced".
+ */
+void selectProfile(parametersT *pparam, Instance *I)
+{
+  if (strcmp(pparam->profile, "auto"))
+    return;
+  if (I->nCourses <= PROFILE_SMALL_COURSES)
+    strcpy(pparam->profile, "tight-bound");
+  else
+    strcpy(pparam->profile, "fast-primal");
+  printf("\nSCIP settings profile (auto) = %s (%d courses, %d professors)\n", pparam->profile, I->nCourses, I->nProfessors);
+}
+void writeSolFile(Instance *I, const int *assign, double value, const char *probname, char *outputname, const parametersT *param)
+{
+  FILE *file;
+  char filename[SCIP_MAXSTRLEN];
+  struct tm *ct;
+  const time_t t = time(NULL);
+
+  (void) SCIPsnprintf(filename, SCIP_MAXSTRLEN, "%s/%s.sol", param->output_path, outputname);
+  file = fopen(filename, "w");
+  if (!file)
+  {
+    printf("\nProblem to create solution file: %s", filename);
+    return;
+  }
+  fprintf(file, "\nValue: %lf\n", value);
+
+  for (int i = 0; i < I->nProfessors; i++)
+  {
+    fprintf(file, "%d - %s:\n", i + 1, I->professors[i].name);
+    int hours = 0;
+    int count = 0;
+    int sum   = 0;
+    float avg;
+    for (int j = 0; j < I->professors[i].numPreferences; j++)
+    {
+      if (assign[j] == i)
+      {
+        count++;
+        sum += I->professors[i].preferences[j].weight;
+        fprintf(file, "%d: %s (%f)\n", j + 1, I->courses[j].subject.name, I->professors[i].preferences[j].weight);
+        hours += I->courses[j].workload;
+      }
+    }
+
+    if (count > 0)
+    {
+      avg = (float) sum / count;
+    }
+    else
+    {
+      avg = 0;
+    }
+
+    fprintf(file, "Average weight assigned by the system: %.2f\n", avg);
+    fprintf(file, "Average weight assigned by the professor: %.2f\n", I->professors[i].avgPreferenceWeight);
+    fprintf(file, "Satisfaction coefficient: %.2f\n\n", I->professors[i].avgPreferenceWeight);
+  }
+
+  fprintf(file, "\n");
+  //
+  fprintf(file, "Parameters settings file=%s\n", param->parameter_stamp);
+  fprintf(file, "SCIP settings profile=%s\n", param->profile);
+  fprintf(file, "Instance file=%s\n", probname);
+  ct = localtime(&t);
+  fprintf(file, "Date=%d-%.2d-%.2d\nTime=%.2d:%.2d:%.2d\n", ct->tm_year + 1900, ct->tm_mon, ct->tm_mday, ct->tm_hour, ct->tm_min, ct->tm_sec);
+  fclose(file);
+}
+
+// TODO: Get the best solution found and write the solution in a file. It depends on the problem!
+void printSol(SCIP *scip, char *outputname, const parametersT *param)
+{
+  SCIP_PROBDATA *probdata;
+  SCIP_SOL *bestSolution;
+  SCIP_VAR **vars;
+  Instance *I;
+  int *assign;
+
+  assert(scip != NULL);
+  bestSolution = SCIPgetBestSol(scip);
+  if (bestSolution == NULL)
+    return;
+  probdata = SCIPgetProbData(scip);
+  assert(probdata != NULL);
+
+  I      = SCIPprobdataGetInstance(probdata);
+  vars   = SCIPprobdataGetVars(probdata);
+  assign = (int *) malloc(sizeof(int) * I->nCourses);
+  if (assign == NULL)
+    return;
+
+  // professor of each course in the best solution (-1 = not assigned)
+  for (int j = 0; j < I->nCourses; j++)
+  {
+    assign[j] = -1;
+    for (int i = 0; i < I->nProfessors; i++)
+    {
+      if (SCIPgetSolVal(scip, bestSolution, vars[(i * (I->nCourses)) + j]) > EPSILON)
+      {
+        assign[j] = i;
+        break;
+      }
+    }
+  }
+  writeSolFile(I, assign, -SCIPsolGetOrigObj(bestSolution), SCIPgetProbName(scip), outputname, param);
+  free(assign);
+}
+
+void removePath(char *fullfilename, char **filename)
+{
+  // remove path, if there exists on fullfilename
+  *filename = strrchr(fullfilename, '/');
+  if (*filename == NULL)
+  {
+    *filename = fullfilename;
+  }
+  else
+  {
+    (*filename)++;  // discard /
+  }
+}
+void configOutputName(char *name, char *instance_filename, char *program, const parametersT *param)
+{
+  char *program_filename, *filename;
+
+  // remove path, if there exists on program name
+  removePath(program, &program_filename);
+  removePath(instance_filename, &filename);
+
+  // append program name and parameter stamp
+  (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "%s/%s-%s-%s", CURRENT_PATH, filename, program_filename, param->parameter_stamp);
+}
+
+/**
+ * solves one instance and writes its .out and .sol files (and the optional incumbent log and checkpoints).
+ * In batch mode (result != NULL), the summary of the solve is stored in result and the SCIP is freed.
+ */
+SCIP_RETCODE solveInstance(char *instance_filename, char *program, parametersT param, BatchResultT *result)
+{
+  SCIP *scip;
+  SCIP_SOL *bestSolution;
+  Instance *in;
+  clock_t start, end;
+  struct timespec wallstart, wallend;
+  double elapsed;
+  char outputname[SCIP_MAXSTRLEN];
+  char checkpointname[SCIP_MAXSTRLEN];
+  char incumbentname[SCIP_MAXSTRLEN];
+  char *filename;
+  CheckpointT ckpt;
+  int resumed;
+
+  // load instance file
+  if (!loadInstance(instance_filename, &in, param.area_penalty))
+  {
+    printf("\nProblem to read instance file %s\n", instance_filename);
+    return SCIP_READERROR;
+  }
+  //  printInstance(in);
+  if (result != NULL)
+  {
+    // the instance belongs to SCIP after loadProblem
+    result->nCourses    = in->nCourses;
+    result->nProfessors = in->nProfessors;
+  }
+  // choose the SCIP settings profile by instance class, if requested
+  selectProfile(&param, in);
+  // anytime results: log of the incumbents
+  removePath(instance_filename, &filename);
+  (void) SCIPsnprintf(incumbentname, SCIP_MAXSTRLEN, "%s/%s.incumbents", param.output_path, filename);
+  if (param.threads > 1)
+  {
+    if (param.checkpoint_freq > 0 || strcmp(param.resume, "none"))
+      printf("\nCheckpoint and resume are ignored with --threads > 1\n");
+    // solve with a portfolio of parallel workers and report the best one
+    scip = portfolioSolve(instance_filename, in, param, param.incumbent_log ? incumbentname : NULL, &elapsed);
+    if (scip == NULL)
+    {
+      printf("\nProblem to solve instance problem with the portfolio\n");
+      return SCIP_ERROR;
+    }
+  }
+  else
+  {
+    // reload a checkpoint and continue with the remaining time budget
+    resumed = 0;
+    if (strcmp(param.resume, "none"))
+    {
+      if (!readCheckpoint(param.resume, &ckpt, in))
+      {
+        freeInstance(in);
+        return SCIP_READERROR;
+      }
+      resumed          = 1;
+      param.time_limit = param.time_limit > ckpt.elapsed ? param.time_limit - ckpt.elapsed : 0;
+    }
+    // create scip and set scip configurations
+    SCIP_CALL(configScip(&scip, &param));
+    // load problem into scip
+    if (!loadProblem(scip, instance_filename, in, 0, NULL))
+    {
+      printf("\nProblem to load instance problem\n");
+      return SCIP_ERROR;
+    }
+    if (resumed)
+    {
+      SCIP_CALL(injectCheckpoint(scip, &ckpt));
+      freeCheckpoint(&ckpt);
+    }
+    if (param.incumbent_log)
+      SCIP_CALL(SCIPincludeEventHdlrIncumbent(scip, incumbentname));
+    if (param.checkpoint_freq > 0)
+    {
+      (void) SCIPsnprintf(checkpointname, SCIP_MAXSTRLEN, "%s/%s.ckpt", param.output_path, filename);
+      SCIP_CALL(SCIPincludeEventHdlrCheckpoint(scip, checkpointname, param.checkpoint_freq, resumed ? ckpt.elapsed : 0.0));
+    }
+    // print problem (only for single runs: batch runs share the output directory)
+    if (result == NULL)
+    {
+      char dpd_lp_path[520];
+      snprintf(dpd_lp_path, sizeof(dpd_lp_path), "%s/dpd.lp", param.output_path);
+      SCIP_CALL(SCIPwriteOrigProblem(scip, dpd_lp_path, "lp", TRUE));
+    }
+    // solve scip problem (batch workers run in parallel, so their time is wall clock instead of CPU time)
+    start = clock();
+    clock_gettime(CLOCK_MONOTONIC, &wallstart);
+    SCIP_CALL(SCIPsolve(scip));
+    end = clock();
+    clock_gettime(CLOCK_MONOTONIC, &wallend);
+    if (result == NULL)
+      elapsed = ((double) (end - start)) / CLOCKS_PER_SEC;
+    else
+      elapsed = (wallend.tv_sec - wallstart.tv_sec) + (wallend.tv_nsec - wallstart.tv_nsec) / 1e9;
+  }
+  if (getInterruptSignal())
+    printf("\nInterrupted by signal %d: writing the best solution found\n", getInterruptSignal());
+  // config output filename
+  configOutputName(outputname, instance_filename, program, &param);
+  // print statistics and print resume in output file
+  printStatistic(scip, elapsed, outputname, &param);
+  // write the best solution in a file
+  printSol(scip, outputname, &param);
+
+  if (result != NULL)
+  {
+    bestSolution   = SCIPgetBestSol(scip);
+    result->solved = 1;
+    result->status = SCIPgetStatus(scip);
+    result->primal = SCIPgetPrimalbound(scip);
+    result->dual   = SCIPgetDualbound(scip);
+    result->gap    = SCIPgetGap(scip);
+    result->time   = elapsed;
+    result->nodes  = SCIPgetNTotalNodes(scip);
+    (void) SCIPsnprintf(result->bestheur, sizeof(result->bestheur), "%s",
+                        bestSolution == NULL ? "none" : (SCIPsolGetHeur(bestSolution) != NULL ? SCIPheurGetName(SCIPsolGetHeur(bestSolution)) : "relaxation"));
+    // a batch keeps running: release the memory of this instance (SCIP also frees the instance)
+    SCIP_CALL(SCIPfree(&scip));
+  }
+  return SCIP_OKAY;
+}
+
+/** heuristic mode: runs GRASP on the instance for --heuristic_time seconds, without a SCIP model, and writes its .sol */
+SCIP_RETCODE solveHeuristic(char *instance_filename, char *program, parametersT param)
+{
+  Instance *in;
+  int *assign;
+  double value = 0.0;
+  long long niterations;
+  int found;
+  struct timespec wallstart, wallend;
+  double elapsed;
+  char outputname[SCIP_MAXSTRLEN];
+
+  if (!loadInstance(instance_filename, &in, param.area_penalty))
+  {
+    printf("\nProblem to read instance file %s\n", instance_filename);
+    return SCIP_READERROR;
+  }
+  assign = (int *) malloc(sizeof(int) * in->nCourses);
+  if (assign == NULL)
+  {
+    freeInstance(in);
+    return SCIP_NOMEMORY;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &wallstart);
+  found = grasp_standalone(in, &param, param.heuristic_time, assign, &value, &niterations);
+  clock_gettime(CLOCK_MONOTONIC, &wallend);
+  elapsed = (wallend.tv_sec - wallstart.tv_sec) + (wallend.tv_nsec - wallstart.tv_nsec) / 1e9;
+  if (found < 0)
+  {
+    free(assign);
+    freeInstance(in);
+    return SCIP_NOMEMORY;
+  }
+  if (getInterruptSignal())
+    printf("\nInterrupted by signal %d: writing the best solution found\n", getInterruptSignal());
+  printf("\nHeuristic mode: %lld iterations in %.2lf s", niterations, elapsed);
+  if (found)
+  {
+    printf(", best value = %.2lf\n", value);
+    // same sign convention as the .sol files of the exact mode
+    configOutputName(outputname, instance_filename, program, &param);
+    writeSolFile(in, assign, -value, instance_filename, outputname, &param);
+  }
+  else
+    printf(", no feasible assignment found\n");
+
+  free(assign);
+  freeInstance(in);
+  return SCIP_OKAY;
+}
+
+/*
+ * handle API
+ */
+
+/** creates a context with the default parameters and no output files; returns NULL if there is no memory */
+DPD_Context *dpdCreate(void)
+{
+  DPD_Context *ctx;
+
+  ctx = (DPD_Context *) calloc(1, sizeof(DPD_Context));
+  if (ctx == NULL)
+    return NULL;
+  setDefaultParameters(&ctx->param);
+  ctx->status = SCIP_STATUS_UNKNOWN;
+  return ctx;
+}
+
+/** frees a context and everything it owns */
+void dpdFree(DPD_Context **pctx)
+{
+  DPD_Context *ctx;
+
+  if (pctx == NULL || *pctx == NULL)
+    return;
+  ctx = *pctx;
+  if (ctx->in != NULL)
+    freeInstance(ctx->in);
+  free(ctx->assignment);
+  free(ctx);
+  *pctx = NULL;
+}
+
+/** sets one parameter of the context given the name of its command line option (with or without "--") */
+int dpdSetParam(DPD_Context *ctx, const char *name, const char *value)
+{
+  char option[SCIP_MAXSTRLEN];
+
+  assert(ctx != NULL);
+  if (name == NULL)
+    return 0;
+  (void) SCIPsnprintf(option, SCIP_MAXSTRLEN, "%s%s", strncmp(name, "--", 2) ? "--" : "", name);
+  return setParameter(&ctx->param, option, value);
+}
+
+/** sets the folder of the .out and .sol files of the next solves ("" = no output files) */
+int dpdSetOutputPath(DPD_Context *ctx, const char *path)
+{
+  assert(ctx != NULL);
+  if (path == NULL || strlen(path) >= sizeof(ctx->param.output_path))
+    return 0;
+  if (*path != '\0')
+    mkdir(path, 0777);
+  strcpy(ctx->param.output_path, path);
+  return 1;
+}
+
+/** loads an instance file, replacing the previous instance and results of the context */
+int dpdLoadInstance(DPD_Context *ctx, const char *filename)
+{
+  assert(ctx != NULL);
+  if (filename == NULL || strlen(filename) >= sizeof(ctx->filename))
+    return 0;
+  if (ctx->in != NULL)
+    freeInstance(ctx->in);
+  free(ctx->assignment);
+  ctx->in         = NULL;
+  ctx->assignment = NULL;
+  ctx->hassol     = 0;
+  ctx->status     = SCIP_STATUS_UNKNOWN;
+  strcpy(ctx->filename, filename);
+  if (!loadInstance(ctx->filename, &ctx->in, ctx->param.area_penalty))
+  {
+    printf("\nProblem to read instance file %s\n", filename);
+    ctx->in = NULL;
+    return 0;
+  }
+  ctx->nCourses    = ctx->in->nCourses;
+  ctx->nProfessors = ctx->in->nProfessors;
+  ctx->assignment  = (int *) malloc(sizeof(int) * ctx->nCourses);
+  if (ctx->assignment == NULL)
+    return 0;
+  return 1;
+}
+
+/** solves the loaded instance and stores the results in the context */
+SCIP_RETCODE dpdSolve(DPD_Context *ctx)
+{
+  parametersT param;
+  SCIP *scip;
+  SCIP_SOL *bestSolution;
+  struct timespec wallstart, wallend;
+  double elapsed;
+  char outputname[SCIP_MAXSTRLEN];
+
+  assert(ctx != NULL);
+  if (ctx->assignment == NULL)
+    return SCIP_INVALIDCALL;
+  // the instance of a previous solve was freed with its SCIP
+  if (ctx->in == NULL && !loadInstance(ctx->filename, &ctx->in, ctx->param.area_penalty))
+  {
+    ctx->in = NULL;
+    return SCIP_READERROR;
+  }
+  ctx->hassol = 0;
+  ctx->status = SCIP_STATUS_UNKNOWN;
+
+  // the context keeps the user parameters ("auto" is resolved for each solve)
+  param       = ctx->param;
+  selectProfile(&param, ctx->in);
+  if (param.threads > 1)
+  {
+    scip    = portfolioSolve(ctx->filename, ctx->in, param, NULL, &elapsed);
+    ctx->in = NULL;
+    if (scip == NULL)
+      return SCIP_ERROR;
+  }
+  else
+  {
+    SCIP_CALL(configScip(&scip, &param));
+    if (!loadProblem(scip, ctx->filename, ctx->in, 0, NULL))
+    {
+      printf("\nProblem to load instance problem\n");
+      SCIP_CALL(SCIPfree(&scip));
+      return SCIP_ERROR;
+    }
+    ctx->in = NULL;
+    clock_gettime(CLOCK_MONOTONIC, &wallstart);
+    SCIP_CALL(SCIPsolve(scip));
+    clock_gettime(CLOCK_MONOTONIC, &wallend);
+    elapsed = (wallend.tv_sec - wallstart.tv_sec) + (wallend.tv_nsec - wallstart.tv_nsec) / 1e9;
+  }
+
+  bestSolution = SCIPgetBestSol(scip);
+  ctx->hassol  = bestSolution != NULL && SCIPprobdataGetAssignment(scip, SCIPgetProbData(scip), bestSolution, ctx->assignment);
+  ctx->status  = SCIPgetStatus(scip);
+  ctx->primal  = SCIPgetPrimalbound(scip);
+  ctx->dual    = SCIPgetDualbound(scip);
+  ctx->gap     = SCIPgetGap(scip);
+  ctx->time    = elapsed;
+  if (*param.output_path != '\0')
+  {
+    configOutputName(outputname, ctx->filename, "libdpd", &param);
+    SCIP_CALL(printStatistic(scip, elapsed, outputname, &param));
+    printSol(scip, outputname, &param);
+  }
+  // SCIP also frees the instance
+  SCIP_CALL(SCIPfree(&scip));
+  return SCIP_OKAY;
+}
+
+/** number of courses of the loaded instance */
+int dpdGetNCourses(const DPD_Context *ctx)
+{
+  assert(ctx != NULL);
+  return ctx->nCourses;
+}
+
+/** number of professors of the loaded instance */
+int dpdGetNProfessors(const DPD_Context *ctx)
+{
+  assert(ctx != NULL);
+  return ctx->nProfessors;
+}
+
+/** SCIP status of the last solve */
+SCIP_STATUS dpdGetStatus(const DPD_Context *ctx)
+{
+  assert(ctx != NULL);
+  return ctx->status;
+}
+
+/** objective value of the best assignment of the last solve */
+SCIP_Real dpdGetPrimalBound(const DPD_Context *ctx)
+{
+  assert(ctx != NULL);
+  return ctx->primal;
+}
+
+/** dual bound of the last solve */
+SCIP_Real dpdGetDualBound(const DPD_Context *ctx)
+{
+  assert(ctx != NULL);
+  return ctx->dual;
+}
+
+/** gap of the last solve */
+SCIP_Real dpdGetGap(const DPD_Context *ctx)
+{
+  assert(ctx != NULL);
+  return ctx->gap;
+}
+
+/** wall clock time of the last solve (in sec) */
+double dpdGetSolvingTime(const DPD_Context *ctx)
+{
+  assert(ctx != NULL);
+  return ctx->time;
+}
+
+/** copies the professor of each course in the best solution of the last solve; returns 1 if there is a solution */
+int dpdGetAssignment(const DPD_Context *ctx, int *assignment)
+{
+  assert(ctx != NULL);
+  if (!ctx->hassol || assignment == NULL)
+    return 0;
+  memcpy(assignment, ctx->assignment, sizeof(int) * ctx->nCourses);
+  return 1;
+}
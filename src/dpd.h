@@ -0,0 +1,114 @@
+/**@file   dpd.h
+ * @brief  libdpd: embeddable solver for the professor-course assignment problem
+ *
+ * The library keeps no process-global state: all settings and results of a solve live in a DPD_Context (or, for the
+ * lower-level functions, in the parametersT passed by the caller), so independent contexts can be used from
+ * different threads at the same time. The only exception is the interrupt flag of event_interrupt.h, since signals
+ * are delivered to the whole process; the library never installs signal handlers by itself.
+ *
+ * Typical use:
+ *   DPD_Context *ctx = dpdCreate();
+ *   dpdSetParam(ctx, "--time", "60");
+ *   dpdLoadInstance(ctx, "input/easy/instance.csv");
+ *   dpdSolve(ctx);
+ *   dpdGetAssignment(ctx, assignment);
+ *   dpdFree(&ctx);
+ **/
+#ifndef __DPD__
+#define __DPD__
+
+#include "batch_dpd.h"
+#include "parameters_dpd.h"
+#include "problem.h"
+#include "scip/scip.h"
+
+/** solver handle (opaque) */
+typedef struct DPD_Context DPD_Context;
+
+/** creates a context with the default parameters and no output files; returns NULL if there is no memory */
+DPD_Context *dpdCreate(void);
+
+/** frees a context and everything it owns */
+void dpdFree(DPD_Context **pctx);
+
+/**
+ * sets one parameter of the context, with the name of the command line option ("--time" or "time") and its value as
+ * a string. Returns 1 if the value is valid, 0 otherwise (the parameter keeps its previous value).
+ * --penalty is applied when the instance is loaded.
+ */
+int dpdSetParam(DPD_Context *ctx, const char *name, const char *value);
+
+/** sets the folder of the .out and .sol files of the next solves ("" = no output files, the default) */
+int dpdSetOutputPath(DPD_Context *ctx, const char *path);
+
+/** loads an instance file, replacing the previous instance and results of the context; returns 1 on success */
+int dpdLoadInstance(DPD_Context *ctx, const char *filename);
+
+/** solves the loaded instance (again, if already solved) and stores the results in the context */
+SCIP_RETCODE dpdSolve(DPD_Context *ctx);
+
+/** number of courses of the loaded instance */
+int dpdGetNCourses(const DPD_Context *ctx);
+
+/** number of professors of the loaded instance */
+int dpdGetNProfessors(const DPD_Context *ctx);
+
+/** SCIP status of the last solve */
+SCIP_STATUS dpdGetStatus(const DPD_Context *ctx);
+
+/** objective value of the best assignment of the last solve */
+SCIP_Real dpdGetPrimalBound(const DPD_Context *ctx);
+
+/** dual bound of the last solve */
+SCIP_Real dpdGetDualBound(const DPD_Context *ctx);
+
+/** gap of the last solve */
+SCIP_Real dpdGetGap(const DPD_Context *ctx);
+
+/** wall clock time of the last solve (in sec) */
+double dpdGetSolvingTime(const DPD_Context *ctx);
+
+/**
+ * copies the professor (0-based) of each course in the best solution of the last solve into assignment, which must
+ * have dpdGetNCourses() entries. Returns 1 if there is a solution, 0 otherwise.
+ */
+int dpdGetAssignment(const DPD_Context *ctx, int *assignment);
+
+/*
+ * lower-level interface, used by the command line program (cmain.c), the batch mode and the LNS sub-SCIP
+ */
+
+/** creates a SCIP instance with default plugins, and set SCIP parameters */
+SCIP_RETCODE configScip(SCIP **pscip, const parametersT *param);
+
+/** resolve profile "auto" into a settings profile according to the instance class (given by its size) */
+void selectProfile(parametersT *pparam, Instance *I);
+
+/** writes the statistics of the solve in <output_path>/<outputname>.out */
+SCIP_RETCODE printStatistic(SCIP *scip, double time, char *outputname, const parametersT *param);
+
+/** writes an assignment (professor of each course, -1 = none) with its value in <output_path>/<outputname>.sol */
+void writeSolFile(Instance *I, const int *assign, double value, const char *probname, char *outputname, const parametersT *param);
+
+/** writes the best solution in <output_path>/<outputname>.sol */
+void printSol(SCIP *scip, char *outputname, const parametersT *param);
+
+/** points filename to the name of fullfilename without its path */
+void removePath(char *fullfilename, char **filename);
+
+/** builds the name of the output files of a run */
+void configOutputName(char *name, char *instance_filename, char *program, const parametersT *param);
+
+/**
+ * solves one instance and writes its .out and .sol files (and the optional incumbent log and checkpoints).
+ * In batch mode (result != NULL), the summary of the solve is stored in result and the SCIP is freed.
+ */
+SCIP_RETCODE solveInstance(char *instance_filename, char *program, parametersT param, BatchResultT *result);
+
+/**
+ * heuristic mode (--mode heuristic): GRASP and local search on the instance for --heuristic_time seconds, without
+ * building the SCIP model; writes the .sol file only.
+ */
+SCIP_RETCODE solveHeuristic(char *instance_filename, char *program, parametersT param);
+
+#endif
@@ -0,0 +1,359 @@
+/**@file   event_checkpoint.c
+ * @brief  periodic checkpoint and resume
+ *
+ * Checkpoint file format (text):
+ *   DPD-CHECKPOINT 1
+ *   courses <n>
+ *   professors <m>
+ *   elapsed <seconds>
+ *   primal <value>
+ *   dual <value>
+ *   lns_last <value> | lns_last none
+ *   solutions <k>
+ *   k lines with the professor of each of the n courses (best solution first)
+ *   grasp_pool <g>
+ *   g lines with the objective value and the professor of each of the n courses of a GRASP elite pool member
+ * The grasp_pool section may be missing (checkpoints written before it existed): the pool then starts empty.
+ **/
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "event_checkpoint.h"
+#include "heur_grasp.h"
+#include "heur_lns.h"
+#include "probdata_dpd.h"
+
+#define EVENTHDLR_NAME "checkpoint"
+#define EVENTHDLR_DESC "writes periodic checkpoints of the solve"
+
+#define CHECKPOINT_HEADER "DPD-CHECKPOINT 1"
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+  char filename[SCIP_MAXSTRLEN]; /**< checkpoint file */
+  int freq;                      /**< seconds between checkpoints */
+  double elapsed;                /**< solving time spent by previous runs */
+  double lastwrite;              /**< solving time of the last checkpoint */
+  int *assignment;               /**< buffer with the professor of each course */
+  int *poolassign;               /**< buffer with the GRASP pool members (GRASP_POOL_SIZE x nCourses) */
+  double *poolvalue;             /**< buffer with the objective value of each GRASP pool member */
+  int filterpos;                 /**< position of the event in the event filter */
+  SCIP_Longint nwritten;         /**< number of checkpoints written */
+};
+
+/*
+ * Local methods
+ */
+
+/** writes the checkpoint atomically: <filename>.tmp is written, flushed to disk and renamed to <filename> */
+static SCIP_RETCODE writeCheckpoint(SCIP *scip, SCIP_EVENTHDLRDATA *eventhdlrdata)
+{
+  char tmpname[SCIP_MAXSTRLEN + 4];
+  SCIP_PROBDATA *probdata;
+  SCIP_HEUR *lns, *grasp;
+  SCIP_SOL **sols;
+  Instance *I;
+  FILE *fout;
+  int nsols, nsaved, npool, s, j;
+
+  probdata = SCIPgetProbData(scip);
+  assert(probdata != NULL);
+  I = SCIPprobdataGetInstance(probdata);
+
+  (void) SCIPsnprintf(tmpname, sizeof(tmpname), "%s.tmp", eventhdlrdata->filename);
+  fout = fopen(tmpname, "w");
+  if (!fout)
+  {
+    printf("\nProblem to create checkpoint file %s\n", tmpname);
+    return SCIP_OKAY;
+  }
+
+  fprintf(fout, "%s\n", CHECKPOINT_HEADER);
+  fprintf(fout, "courses %d\nprofessors %d\n", I->nCourses, I->nProfessors);
+  fprintf(fout, "elapsed %.3lf\n", eventhdlrdata->elapsed + SCIPgetSolvingTime(scip));
+  fprintf(fout, "primal %.17g\ndual %.17g\n", SCIPgetPrimalbound(scip), SCIPgetDualbound(scip));
+  lns = SCIPfindHeur(scip, "lns");
+  if (lns != NULL)
+    fprintf(fout, "lns_last %.17g\n", SCIPheurLnsGetLastSolValue(lns));
+  else
+    fprintf(fout, "lns_last none\n");
+
+  // best solutions of the pool (already sorted, best first); solutions with unassigned courses are skipped
+  nsols  = SCIPgetNSols(scip);
+  sols   = SCIPgetSols(scip);
+  nsaved = 0;
+  for (s = 0; s < nsols && nsaved < CHECKPOINT_MAXSOLS; s++)
+  {
+    if (SCIPprobdataGetAssignment(scip, probdata, sols[s], eventhdlrdata->assignment + nsaved * I->nCourses))
+      nsaved++;
+  }
+  fprintf(fout, "solutions %d\n", nsaved);
+  for (s = 0; s < nsaved; s++)
+  {
+    for (j = 0; j < I->nCourses; j++)
+      fprintf(fout, "%d%c", eventhdlrdata->assignment[s * I->nCourses + j], j + 1 < I->nCourses ? ' ' : '\n');
+  }
+
+  // persistent elite pool of GRASP (empty if GRASP or its pool is not used)
+  grasp = SCIPfindHeur(scip, "grasp");
+  npool = grasp != NULL ? SCIPheurGraspGetPool(grasp, eventhdlrdata->poolassign, eventhdlrdata->poolvalue) : 0;
+  fprintf(fout, "grasp_pool %d\n", npool);
+  for (s = 0; s < npool; s++)
+  {
+    fprintf(fout, "%.17g", eventhdlrdata->poolvalue[s]);
+    for (j = 0; j < I->nCourses; j++)
+      fprintf(fout, " %d", eventhdlrdata->poolassign[s * I->nCourses + j]);
+    fprintf(fout, "\n");
+  }
+
+  if (fflush(fout) != 0 || fsync(fileno(fout)) != 0)
+  {
+    printf("\nProblem to write checkpoint file %s\n", tmpname);
+    fclose(fout);
+    return SCIP_OKAY;
+  }
+  fclose(fout);
+  if (rename(tmpname, eventhdlrdata->filename) != 0)
+  {
+    printf("\nProblem to rename checkpoint file %s\n", tmpname);
+    return SCIP_OKAY;
+  }
+  eventhdlrdata->lastwrite = SCIPgetSolvingTime(scip);
+  eventhdlrdata->nwritten++;
+  return SCIP_OKAY;
+}
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static SCIP_DECL_EVENTFREE(eventFreeCheckpoint)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  SCIPfreeMemory(scip, &eventhdlrdata);
+  SCIPeventhdlrSetData(eventhdlr, NULL);
+
+  return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static SCIP_DECL_EVENTINITSOL(eventInitsolCheckpoint)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+  Instance *I;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  I = SCIPprobdataGetInstance(SCIPgetProbData(scip));
+  SCIP_CALL(SCIPallocMemoryArray(scip, &eventhdlrdata->assignment, CHECKPOINT_MAXSOLS * I->nCourses));
+  SCIP_CALL(SCIPallocMemoryArray(scip, &eventhdlrdata->poolassign, GRASP_POOL_SIZE * I->nCourses));
+  SCIP_CALL(SCIPallocMemoryArray(scip, &eventhdlrdata->poolvalue, GRASP_POOL_SIZE));
+  eventhdlrdata->lastwrite = 0.0;
+  SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, &eventhdlrdata->filterpos));
+
+  return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static SCIP_DECL_EVENTEXITSOL(eventExitsolCheckpoint)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  // final checkpoint, so that a resumed run starts from the end of this one
+  SCIP_CALL(writeCheckpoint(scip, eventhdlrdata));
+  printf("\nCheckpoints written: %lld (%s)\n", eventhdlrdata->nwritten, eventhdlrdata->filename);
+
+  SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_NODESOLVED, eventhdlr, NULL, eventhdlrdata->filterpos));
+  SCIPfreeMemoryArray(scip, &eventhdlrdata->assignment);
+  SCIPfreeMemoryArray(scip, &eventhdlrdata->poolassign);
+  SCIPfreeMemoryArray(scip, &eventhdlrdata->poolvalue);
+
+  return SCIP_OKAY;
+}
+
+/** execution method of event handler */
+static SCIP_DECL_EVENTEXEC(eventExecCheckpoint)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  if (SCIPgetSolvingTime(scip) - eventhdlrdata->lastwrite >= eventhdlrdata->freq)
+    SCIP_CALL(writeCheckpoint(scip, eventhdlrdata));
+
+  return SCIP_OKAY;
+}
+
+/*
+ * Interface methods
+ */
+
+/** creates the checkpoint event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventHdlrCheckpoint(
+        SCIP *scip,           /**< SCIP data structure */
+        const char *filename, /**< checkpoint file */
+        int freq,             /**< seconds between checkpoints */
+        double elapsed        /**< solving time already spent by previous runs (resume) */
+)
+{
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+  SCIP_EVENTHDLR *eventhdlr;
+
+  SCIP_CALL(SCIPallocMemory(scip, &eventhdlrdata));
+  (void) SCIPsnprintf(eventhdlrdata->filename, SCIP_MAXSTRLEN, "%s", filename);
+  eventhdlrdata->freq       = freq;
+  eventhdlrdata->elapsed    = elapsed;
+  eventhdlrdata->lastwrite  = 0.0;
+  eventhdlrdata->assignment = NULL;
+  eventhdlrdata->poolassign = NULL;
+  eventhdlrdata->poolvalue  = NULL;
+  eventhdlrdata->filterpos  = -1;
+  eventhdlrdata->nwritten   = 0;
+
+  eventhdlr                 = NULL;
+  SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecCheckpoint, eventhdlrdata));
+  assert(eventhdlr != NULL);
+
+  SCIP_CALL(SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeCheckpoint));
+  SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolCheckpoint));
+  SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolCheckpoint));
+
+  return SCIP_OKAY;
+}
+
+/** reads a checkpoint file written for instance I; returns 1 on success */
+int readCheckpoint(const char *filename, CheckpointT *ckpt, Instance *I)
+{
+  char header[64], lnslast[64];
+  FILE *fin;
+  int s, j, ok;
+
+  ckpt->sols      = NULL;
+  ckpt->nsols     = 0;
+  ckpt->pool      = NULL;
+  ckpt->poolvalue = NULL;
+  ckpt->npool     = 0;
+  fin             = fopen(filename, "r");
+  if (!fin)
+  {
+    printf("\nProblem to open checkpoint file %s\n", filename);
+    return 0;
+  }
+
+  ok = fgets(header, sizeof(header), fin) != NULL && !strncmp(header, CHECKPOINT_HEADER, strlen(CHECKPOINT_HEADER));
+  ok = ok && fscanf(fin, " courses %d professors %d", &ckpt->nCourses, &ckpt->nProfessors) == 2;
+  ok = ok && fscanf(fin, " elapsed %lf primal %lf dual %lf", &ckpt->elapsed, &ckpt->primal, &ckpt->dual) == 3;
+  ok = ok && fscanf(fin, " lns_last %63s", lnslast) == 1;
+  ok = ok && fscanf(fin, " solutions %d", &ckpt->nsols) == 1 && ckpt->nsols >= 0 && ckpt->nsols <= CHECKPOINT_MAXSOLS;
+  if (ok && (ckpt->nCourses != I->nCourses || ckpt->nProfessors != I->nProfessors))
+  {
+    printf("\nCheckpoint %s is for an instance with %d courses and %d professors\n", filename, ckpt->nCourses, ckpt->nProfessors);
+    ok = 0;
+  }
+  if (ok)
+  {
+    ckpt->hasLnsLast = strcmp(lnslast, "none") != 0;
+    if (ckpt->hasLnsLast)
+      ckpt->lnsLastSolValue = atof(lnslast);
+    ckpt->sols = (int *) malloc((ckpt->nsols * ckpt->nCourses + 1) * sizeof(int));
+    ok         = ckpt->sols != NULL;
+  }
+  for (s = 0; ok && s < ckpt->nsols; s++)
+  {
+    for (j = 0; ok && j < ckpt->nCourses; j++)
+    {
+      int *prof = &ckpt->sols[s * ckpt->nCourses + j];
+      ok        = fscanf(fin, "%d", prof) == 1 && *prof >= 0 && *prof < ckpt->nProfessors;
+    }
+  }
+
+  // optional GRASP elite pool
+  if (ok && fscanf(fin, " grasp_pool %d", &ckpt->npool) == 1)
+  {
+    ok              = ckpt->npool >= 0 && ckpt->npool <= GRASP_POOL_SIZE;
+    ckpt->pool      = ok ? (int *) malloc((ckpt->npool * ckpt->nCourses + 1) * sizeof(int)) : NULL;
+    ckpt->poolvalue = ok ? (double *) malloc((ckpt->npool + 1) * sizeof(double)) : NULL;
+    ok              = ckpt->pool != NULL && ckpt->poolvalue != NULL;
+  }
+  else
+    ckpt->npool = 0;
+  for (s = 0; ok && s < ckpt->npool; s++)
+  {
+    ok = fscanf(fin, "%lf", &ckpt->poolvalue[s]) == 1;
+    for (j = 0; ok && j < ckpt->nCourses; j++)
+    {
+      int *prof = &ckpt->pool[s * ckpt->nCourses + j];
+      ok        = fscanf(fin, "%d", prof) == 1 && *prof >= 0 && *prof < ckpt->nProfessors;
+    }
+  }
+  fclose(fin);
+
+  if (!ok)
+  {
+    printf("\nInvalid checkpoint file %s\n", filename);
+    freeCheckpoint(ckpt);
+    return 0;
+  }
+  return 1;
+}
+
+/** frees the solutions and the pool members of a checkpoint */
+void freeCheckpoint(CheckpointT *ckpt)
+{
+  free(ckpt->sols);
+  free(ckpt->pool);
+  free(ckpt->poolvalue);
+  ckpt->sols      = NULL;
+  ckpt->nsols     = 0;
+  ckpt->pool      = NULL;
+  ckpt->poolvalue = NULL;
+  ckpt->npool     = 0;
+}
+
+/** injects the saved solutions and the heuristic state of a checkpoint in scip (problem stage) */
+SCIP_RETCODE injectCheckpoint(SCIP *scip, CheckpointT *ckpt)
+{
+  SCIP_PROBDATA *probdata;
+  SCIP_HEUR *lns, *grasp;
+  SCIP_SOL *sol;
+  SCIP_Bool stored;
+  int s, nstored;
+
+  probdata = SCIPgetProbData(scip);
+  assert(probdata != NULL);
+
+  nstored = 0;
+  for (s = 0; s < ckpt->nsols; s++)
+  {
+    SCIP_CALL(SCIPcreateSol(scip, &sol, NULL));
+    SCIP_CALL(SCIPprobdataSetAssignment(scip, probdata, sol, ckpt->sols + s * ckpt->nCourses));
+    SCIP_CALL(SCIPaddSolFree(scip, &sol, &stored));
+    if (stored)
+      nstored++;
+  }
+
+  lns = SCIPfindHeur(scip, "lns");
+  if (lns != NULL && ckpt->hasLnsLast)
+    SCIPheurLnsSetLastSolValue(lns, ckpt->lnsLastSolValue);
+  grasp = SCIPfindHeur(scip, "grasp");
+  if (grasp != NULL && ckpt->npool > 0)
+    SCIP_CALL(SCIPheurGraspSetPool(scip, grasp, ckpt->pool, ckpt->poolvalue, ckpt->npool, ckpt->nCourses));
+
+  printf("\nResumed from checkpoint: %.1lfs already spent, primal %lf, dual %lf, %d of %d solutions stored, %d GRASP pool members\n",
+         ckpt->elapsed, ckpt->primal, ckpt->dual, nstored, ckpt->nsols, grasp != NULL ? ckpt->npool : 0);
+  return SCIP_OKAY;
+}
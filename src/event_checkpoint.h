@@ -0,0 +1,51 @@
+/**@file   event_checkpoint.h
+ * @brief  periodic checkpoint of the solve (incumbent, best bound and heuristic state) and resume from it
+ *
+ * The checkpoint holds the best solutions of SCIP and the state of the DPD heuristics: the last solution value seen by
+ * LNS and the persistent elite pool of GRASP. The event handler writes the checkpoint every checkpoint_freq seconds of
+ * solving time (checked after each node) and once more when the solve ends. The file is first written to <file>.tmp
+ * and then renamed, so a crash never leaves a truncated checkpoint behind.
+ **/
+#ifndef __EVENT_CHECKPOINT__
+#define __EVENT_CHECKPOINT__
+
+#include "problem.h"
+#include "scip/scip.h"
+
+#define CHECKPOINT_MAXSOLS 10 /* number of solutions of the solution pool saved (the first one is the incumbent) */
+
+/** contents of a checkpoint file */
+typedef struct
+{
+  int nCourses;              /**< number of courses of the instance */
+  int nProfessors;           /**< number of professors of the instance */
+  double elapsed;            /**< solving time already spent, summed over all resumed runs */
+  SCIP_Real primal;          /**< primal bound */
+  SCIP_Real dual;            /**< dual bound */
+  SCIP_Bool hasLnsLast;      /**< was the LNS state saved? */
+  SCIP_Real lnsLastSolValue; /**< objective value of the last solution processed by LNS */
+  int nsols;                 /**< number of saved solutions */
+  int *sols;                 /**< professor of each course, for each saved solution (nsols x nCourses) */
+  int npool;                 /**< number of saved members of the GRASP elite pool */
+  int *pool;                 /**< professor of each course, for each pool member (npool x nCourses) */
+  double *poolvalue;         /**< objective value of each pool member */
+} CheckpointT;
+
+/** creates the checkpoint event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventHdlrCheckpoint(
+        SCIP *scip,           /**< SCIP data structure */
+        const char *filename, /**< checkpoint file */
+        int freq,             /**< seconds between checkpoints */
+        double elapsed        /**< solving time already spent by previous runs (resume) */
+);
+
+/** reads a checkpoint file written for instance I; returns 1 on success */
+int readCheckpoint(const char *filename, CheckpointT *ckpt, Instance *I);
+
+/** frees the solutions and the pool members of a checkpoint */
+void freeCheckpoint(CheckpointT *ckpt);
+
+/** injects the saved solutions and the heuristic state of a checkpoint in scip (problem stage) */
+SCIP_RETCODE injectCheckpoint(SCIP *scip, CheckpointT *ckpt);
+
+#endif
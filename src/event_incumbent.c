@@ -0,0 +1,176 @@
+/**@file   event_incumbent.c
+ * @brief  streaming incumbent writer driven by SCIP_EVENTTYPE_BESTSOLFOUND
+ **/
+#include <assert.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#include "event_incumbent.h"
+#include "probdata_dpd.h"
+
+#define EVENTHDLR_NAME "incumbent"
+#define EVENTHDLR_DESC "appends each new best solution to a log file"
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+  char filename[SCIP_MAXSTRLEN]; /**< log file ("" = no log file) */
+  FILE *file;                    /**< log file, open during the solve */
+  FILE *stream;                  /**< stream of the caller that also receives the incumbents (NULL = none) */
+  char tag[SCIP_MAXSTRLEN];      /**< first field of the lines written to stream */
+  int *assignment;               /**< buffer with the professor of each course */
+  int filterpos;                 /**< position of the event in the event filter */
+};
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static SCIP_DECL_EVENTFREE(eventFreeIncumbent)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  SCIPfreeMemory(scip, &eventhdlrdata);
+  SCIPeventhdlrSetData(eventhdlr, NULL);
+
+  return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static SCIP_DECL_EVENTINITSOL(eventInitsolIncumbent)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+  Instance *I;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  if (*eventhdlrdata->filename != '\0')
+  {
+    eventhdlrdata->file = fopen(eventhdlrdata->filename, "a");
+    if (!eventhdlrdata->file)
+      printf("\nProblem to create incumbent log %s\n", eventhdlrdata->filename);
+  }
+  I = SCIPprobdataGetInstance(SCIPgetProbData(scip));
+  SCIP_CALL(SCIPallocMemoryArray(scip, &eventhdlrdata->assignment, I->nCourses));
+  SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, &eventhdlrdata->filterpos));
+
+  return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static SCIP_DECL_EVENTEXITSOL(eventExitsolIncumbent)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, NULL, eventhdlrdata->filterpos));
+  SCIPfreeMemoryArray(scip, &eventhdlrdata->assignment);
+  if (eventhdlrdata->file)
+    fclose(eventhdlrdata->file);
+  eventhdlrdata->file = NULL;
+
+  return SCIP_OKAY;
+}
+
+/** execution method of event handler */
+static SCIP_DECL_EVENTEXEC(eventExecIncumbent)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+  SCIP_PROBDATA *probdata;
+  SCIP_SOL *sol;
+  SCIP_HEUR *heur;
+  const char *heurname;
+  struct timeval now;
+  int j, nCourses;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  sol      = SCIPeventGetSol(event);
+  probdata = SCIPgetProbData(scip);
+  if (sol == NULL || !SCIPprobdataGetAssignment(scip, probdata, sol, eventhdlrdata->assignment))
+    return SCIP_OKAY;
+
+  heur     = SCIPsolGetHeur(sol);
+  heurname = heur != NULL ? SCIPheurGetName(heur) : (SCIPsolGetRunnum(sol) == 0 ? "initial" : "relaxation");
+  nCourses = SCIPprobdataGetInstance(probdata)->nCourses;
+  if (eventhdlrdata->file)
+  {
+    gettimeofday(&now, NULL);
+    fprintf(eventhdlrdata->file, "%ld.%03ld;%.3lf;%lf;%s;", (long) now.tv_sec, (long) now.tv_usec / 1000, SCIPgetSolvingTime(scip),
+            SCIPgetSolOrigObj(scip, sol), heurname);
+    for (j = 0; j < nCourses; j++)
+      fprintf(eventhdlrdata->file, "%d%c", eventhdlrdata->assignment[j] + 1, j + 1 < nCourses ? ' ' : '\n');
+    fflush(eventhdlrdata->file);
+  }
+  if (eventhdlrdata->stream)
+  {
+    fprintf(eventhdlrdata->stream, "%s %.3lf %lf %s", eventhdlrdata->tag, SCIPgetSolvingTime(scip), SCIPgetSolOrigObj(scip, sol), heurname);
+    for (j = 0; j < nCourses; j++)
+      fprintf(eventhdlrdata->stream, " %d", eventhdlrdata->assignment[j] + 1);
+    fprintf(eventhdlrdata->stream, "\n");
+    fflush(eventhdlrdata->stream);
+  }
+
+  return SCIP_OKAY;
+}
+
+/*
+ * Interface methods
+ */
+
+/** creates the incumbent writer event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventHdlrIncumbent(
+        SCIP *scip,          /**< SCIP data structure */
+        const char *filename /**< log file (opened in append mode; "" = no log file) */
+)
+{
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+  SCIP_EVENTHDLR *eventhdlr;
+
+  SCIP_CALL(SCIPallocMemory(scip, &eventhdlrdata));
+  (void) SCIPsnprintf(eventhdlrdata->filename, SCIP_MAXSTRLEN, "%s", filename);
+  eventhdlrdata->file       = NULL;
+  eventhdlrdata->stream     = NULL;
+  *eventhdlrdata->tag       = '\0';
+  eventhdlrdata->assignment = NULL;
+  eventhdlrdata->filterpos  = -1;
+
+  eventhdlr                 = NULL;
+  SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecIncumbent, eventhdlrdata));
+  assert(eventhdlr != NULL);
+
+  SCIP_CALL(SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeIncumbent));
+  SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolIncumbent));
+  SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolIncumbent));
+
+  return SCIP_OKAY;
+}
+
+/** sets the stream that also receives the incumbents of the next solves, one line "<tag> <time> <obj> <heur> <profs>" each */
+SCIP_RETCODE SCIPsetIncumbentStream(
+        SCIP *scip,      /**< SCIP data structure */
+        FILE *stream,    /**< stream (not closed by the event handler; NULL = none) */
+        const char *tag  /**< first field of each line */
+)
+{
+  SCIP_EVENTHDLR *eventhdlr;
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+  if (eventhdlr == NULL)
+    return SCIP_INVALIDCALL;
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+  eventhdlrdata->stream = stream;
+  (void) SCIPsnprintf(eventhdlrdata->tag, SCIP_MAXSTRLEN, "%s", tag != NULL ? tag : "");
+
+  return SCIP_OKAY;
+}
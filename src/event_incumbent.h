@@ -0,0 +1,30 @@
+/**@file   event_incumbent.h
+ * @brief  streaming incumbent writer: appends every new best solution to a log file as soon as it is found
+ *
+ * One line per incumbent, fields separated by ';':
+ *   <wall clock (epoch seconds)>;<solving time>;<objective>;<heuristic>;<professor of course 1> ... <professor of course n>
+ * Professors are numbered from 1, as in the .sol file.
+ * The file is flushed after each line, so the last line is always the best assignment found so far.
+ * The incumbents can also be streamed to an open FILE (e.g. a socket of the daemon mode), see SCIPsetIncumbentStream().
+ **/
+#ifndef __EVENT_INCUMBENT__
+#define __EVENT_INCUMBENT__
+
+#include <stdio.h>
+
+#include "scip/scip.h"
+
+/** creates the incumbent writer event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventHdlrIncumbent(
+        SCIP *scip,          /**< SCIP data structure */
+        const char *filename /**< log file (opened in append mode; "" = no log file) */
+);
+
+/** sets the stream that also receives the incumbents of the next solves, one line "<tag> <time> <obj> <heur> <profs>" each */
+SCIP_RETCODE SCIPsetIncumbentStream(
+        SCIP *scip,      /**< SCIP data structure */
+        FILE *stream,    /**< stream (not closed by the event handler; NULL = none) */
+        const char *tag  /**< first field of each line */
+);
+
+#endif
@@ -0,0 +1,153 @@
+/**@file   event_interrupt.c
+ * @brief  graceful interrupt on SIGINT/SIGTERM
+ **/
+#include <assert.h>
+#include <signal.h>
+#include <string.h>
+
+#include "event_interrupt.h"
+
+#define EVENTHDLR_NAME "interrupt"
+#define EVENTHDLR_DESC "stops the solve when SIGINT or SIGTERM is received"
+#define EVENTHDLR_EVENTS (SCIP_EVENTTYPE_NODESOLVED | SCIP_EVENTTYPE_LPSOLVED)
+
+static volatile sig_atomic_t interrupt_signal = 0; /* signal received (0 = none) */
+
+static void signalHandler(int signum)
+{
+  interrupt_signal = signum;
+}
+
+/** event handler data */
+struct SCIP_EventhdlrData
+{
+  int filterpos;          /**< position of the event in the event filter */
+  volatile int *cancel;   /**< flag of the caller that also stops the solve when set (NULL = only signals) */
+};
+
+/*
+ * Callback methods of event handler
+ */
+
+/** destructor of event handler to free user data (called when SCIP is exiting) */
+static SCIP_DECL_EVENTFREE(eventFreeInterrupt)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  SCIPfreeMemory(scip, &eventhdlrdata);
+  SCIPeventhdlrSetData(eventhdlr, NULL);
+
+  return SCIP_OKAY;
+}
+
+/** solving process initialization method of event handler (called when branch and bound process is about to begin) */
+static SCIP_DECL_EVENTINITSOL(eventInitsolInterrupt)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  SCIP_CALL(SCIPcatchEvent(scip, EVENTHDLR_EVENTS, eventhdlr, NULL, &eventhdlrdata->filterpos));
+
+  // signal received (or solve canceled) before the solve started (e.g. while loading the problem)
+  if (interrupt_signal || (eventhdlrdata->cancel != NULL && *eventhdlrdata->cancel))
+    SCIP_CALL(SCIPinterruptSolve(scip));
+
+  return SCIP_OKAY;
+}
+
+/** solving process deinitialization method of event handler (called before branch and bound process data is freed) */
+static SCIP_DECL_EVENTEXITSOL(eventExitsolInterrupt)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  SCIP_CALL(SCIPdropEvent(scip, EVENTHDLR_EVENTS, eventhdlr, NULL, eventhdlrdata->filterpos));
+
+  return SCIP_OKAY;
+}
+
+/** execution method of event handler */
+static SCIP_DECL_EVENTEXEC(eventExecInterrupt)
+{ /*lint --e{715}*/
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+
+  if ((interrupt_signal || (eventhdlrdata->cancel != NULL && *eventhdlrdata->cancel)) && !SCIPisSolveInterrupted(scip))
+    SCIP_CALL(SCIPinterruptSolve(scip));
+
+  return SCIP_OKAY;
+}
+
+/*
+ * Interface methods
+ */
+
+/** installs the SIGINT/SIGTERM handlers */
+void installSignalHandlers(void)
+{
+  struct sigaction action;
+
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = signalHandler;
+  action.sa_flags   = SA_RESETHAND;  // a second signal uses the default action (terminates)
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+}
+
+/** returns the signal received (0 = none) */
+int getInterruptSignal(void)
+{
+  return interrupt_signal;
+}
+
+/** creates the interrupt event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventHdlrInterrupt(
+        SCIP *scip /**< SCIP data structure */
+)
+{
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+  SCIP_EVENTHDLR *eventhdlr;
+
+  SCIP_CALL(SCIPallocMemory(scip, &eventhdlrdata));
+  eventhdlrdata->filterpos = -1;
+  eventhdlrdata->cancel    = NULL;
+
+  eventhdlr                = NULL;
+  SCIP_CALL(SCIPincludeEventhdlrBasic(scip, &eventhdlr, EVENTHDLR_NAME, EVENTHDLR_DESC, eventExecInterrupt, eventhdlrdata));
+  assert(eventhdlr != NULL);
+
+  SCIP_CALL(SCIPsetEventhdlrFree(scip, eventhdlr, eventFreeInterrupt));
+  SCIP_CALL(SCIPsetEventhdlrInitsol(scip, eventhdlr, eventInitsolInterrupt));
+  SCIP_CALL(SCIPsetEventhdlrExitsol(scip, eventhdlr, eventExitsolInterrupt));
+
+  return SCIP_OKAY;
+}
+
+/** sets a cancel flag that stops the solves of this SCIP like a signal does (NULL = only signals) */
+SCIP_RETCODE SCIPsetInterruptCancelFlag(
+        SCIP *scip,           /**< SCIP data structure */
+        volatile int *cancel  /**< flag owned by the caller, set from any thread to cancel the solve */
+)
+{
+  SCIP_EVENTHDLR *eventhdlr;
+  SCIP_EVENTHDLRDATA *eventhdlrdata;
+
+  eventhdlr = SCIPfindEventhdlr(scip, EVENTHDLR_NAME);
+  if (eventhdlr == NULL)
+    return SCIP_INVALIDCALL;
+  eventhdlrdata = SCIPeventhdlrGetData(eventhdlr);
+  assert(eventhdlrdata != NULL);
+  eventhdlrdata->cancel = cancel;
+
+  return SCIP_OKAY;
+}
@@ -0,0 +1,30 @@
+/**@file   event_interrupt.h
+ * @brief  graceful interrupt: SIGINT/SIGTERM ask every SCIP (main, portfolio workers and LNS sub-SCIPs) to stop, so
+ *         that main still writes the best assignment (.sol) and the statistics (.out)
+ *
+ * The signal handler only sets a flag; the event handler, included by configScip in every SCIP, checks the flag
+ * after each LP and each node and calls SCIPinterruptSolve(). A second signal terminates the program immediately.
+ **/
+#ifndef __EVENT_INTERRUPT__
+#define __EVENT_INTERRUPT__
+
+#include "scip/scip.h"
+
+/** installs the SIGINT/SIGTERM handlers */
+void installSignalHandlers(void);
+
+/** returns the signal received (0 = none) */
+int getInterruptSignal(void);
+
+/** creates the interrupt event handler and includes it in SCIP */
+SCIP_RETCODE SCIPincludeEventHdlrInterrupt(
+        SCIP *scip /**< SCIP data structure */
+);
+
+/** sets a cancel flag that stops the solves of this SCIP like a signal does (NULL = only signals) */
+SCIP_RETCODE SCIPsetInterruptCancelFlag(
+        SCIP *scip,           /**< SCIP data structure */
+        volatile int *cancel  /**< flag owned by the caller, set from any thread to cancel the solve */
+);
+
+#endif
@@ -282,11 +282,17 @@ const int NUM_FEASIBLE_SOLUTION_VARS = sizeof(FEASIBLE_SOLUTION) / sizeof(FEASIB
 #endif
 
 /*
- * Global variables for heuristic data
+ * Data structures
  */
-static char **g_heuristic_solution_var_names = NULL;   // Array to hold variable names from FEASIBLE_SOLUTION
-static int g_num_heuristic_solution_vars     = 0;      // Number of variables in the heuristic solution
-static SCIP_Bool g_is_heuristic_initialized  = FALSE;  // Flag to check if the heuristic has been initializeds
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+  int *professors;       /**< professor index of each assignment in FEASIBLE_SOLUTION */
+  int *courses;          /**< course index of each assignment in FEASIBLE_SOLUTION */
+  int nassignments;      /**< number of parsed assignments */
+  SCIP_Bool initialized; /**< whether FEASIBLE_SOLUTION was already parsed */
+};
 
 /*
  * Local methods
@@ -302,9 +308,7 @@ static SCIP_Bool g_is_heuristic_initialized  = FALSE;  // Flag to check if the h
 static SCIP_DECL_HEURCOPY(heurCopyBadFeasible)
 { /*lint --e{715}*/
   /* Indicate that this heuristic does not support copying by returning SCIP_OKAY
-   * and doing nothing. If it needs to be copyable, data would need deep copying.
-   * For now, global data is shared if SCIP instances are copied, which might be an issue.
-   * However, standard SCIP usage doesn't typically copy heuristics with global state like this.
+   * and doing nothing. If it needs to be copyable, the heuristic data would need deep copying.
    */
   return SCIP_OKAY;
 }
@@ -312,55 +316,53 @@ static SCIP_DECL_HEURCOPY(heurCopyBadFeasible)
 /** destructor of primal heuristic to free user data (called when SCIP is exiting) */
 static SCIP_DECL_HEURFREE(heurFreeBadFeasible)
 { /*lint --e{715}*/
+  SCIP_HEURDATA *heurdata;
+
   assert(scip != NULL);
-  if (g_heuristic_solution_var_names != NULL)
-  {
-    for (int i = 0; i < g_num_heuristic_solution_vars; ++i)
-    {
-      if (g_heuristic_solution_var_names[i] != NULL)
-      {
-        SCIPfreeBlockMemory(scip, &g_heuristic_solution_var_names[i]);
-      }
-    }
-    SCIPfreeBufferArray(scip, &g_heuristic_solution_var_names);
-  }
-  g_num_heuristic_solution_vars = 0;
-  g_is_heuristic_initialized    = FALSE;
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  if (heurdata->professors != NULL)
+    SCIPfreeMemoryArray(scip, &heurdata->professors);
+  if (heurdata->courses != NULL)
+    SCIPfreeMemoryArray(scip, &heurdata->courses);
+
+  SCIPfreeMemory(scip, &heurdata);
+  SCIPheurSetData(heur, NULL);
+
   return SCIP_OKAY;
 }
 
 /** initialization method of primal heuristic (called after problem was transformed) */
 static SCIP_DECL_HEURINIT(heurInitBadFeasible)
 { /*lint --e{715}*/
-  if (!g_is_heuristic_initialized)
-  {
-    SCIP_CALL(SCIPallocBufferArray(scip, &g_heuristic_solution_var_names, NUM_FEASIBLE_SOLUTION_VARS));
-    if (g_heuristic_solution_var_names == NULL)
-    {
-      SCIPerrorMessage("Memory allocation failed for g_heuristic_solution_var_names buffer in heurInitBadFeasible.\\n");
-      return SCIP_NOMEMORY;
-    }
+  SCIP_HEURDATA *heurdata;
+
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  if (heurdata->initialized)
+    return SCIP_OKAY;
+
+  /* translate the variable names into (professor, course) pairs once, so the execution looks variables up by index */
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->professors, NUM_FEASIBLE_SOLUTION_VARS));
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->courses, NUM_FEASIBLE_SOLUTION_VARS));
 
-    for (int i = 0; i < NUM_FEASIBLE_SOLUTION_VARS; ++i)
+  heurdata->nassignments = 0;
+  for (int i = 0; i < NUM_FEASIBLE_SOLUTION_VARS; ++i)
+  {
+    int professor, course;
+    if (sscanf(FEASIBLE_SOLUTION[i], "x_%d_%d", &professor, &course) != 2)
     {
-      size_t len = strlen(FEASIBLE_SOLUTION[i]);
-      SCIP_CALL(SCIPallocBlockMemoryArray(scip, &g_heuristic_solution_var_names[i], len + 1));
-      if (g_heuristic_solution_var_names[i] == NULL)
-      {
-        SCIPerrorMessage("Memory allocation failed for a var name string in heurInitBadFeasible.\\n");
-        // Free already allocated strings
-        for (int k = 0; k < i; ++k)
-        {
-          if (g_heuristic_solution_var_names[k] != NULL) SCIPfreeBlockMemory(scip, &g_heuristic_solution_var_names[k]);
-        }
-        SCIPfreeBufferArray(scip, &g_heuristic_solution_var_names);
-        return SCIP_NOMEMORY;
-      }
-      strncpy(g_heuristic_solution_var_names[i], FEASIBLE_SOLUTION[i], len + 1);
+      SCIPerrorMessage("Invalid variable name <%s> in FEASIBLE_SOLUTION.\n", FEASIBLE_SOLUTION[i]);
+      continue;
     }
-    g_num_heuristic_solution_vars = NUM_FEASIBLE_SOLUTION_VARS;
-    g_is_heuristic_initialized    = TRUE;
+    heurdata->professors[heurdata->nassignments] = professor;
+    heurdata->courses[heurdata->nassignments]    = course;
+    heurdata->nassignments++;
   }
+  heurdata->initialized = TRUE;
+
   return SCIP_OKAY;
 }
 
@@ -399,8 +401,8 @@ int bad_feasible_solution(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur)
 
   /* SCIP specific types */
   SCIP_PROBDATA *probdata       = NULL;
+  SCIP_HEURDATA *heurdata       = NULL;
   SCIP_VAR **vars_for_sol_array = NULL;
-  SCIP_VAR *current_scip_var    = NULL;
 
   /* Custom SCIP data types */
   Instance *I                   = NULL;
@@ -415,7 +417,10 @@ int bad_feasible_solution(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur)
   SCIPinfoMessage(scip, NULL, "\\n============== New heuristic: building solution from FEASIBLE_SOLUTION at node: %lld\\n", SCIPnodeGetNumber(SCIPgetCurrentNode(scip)));
 #endif
 
-  if (!g_is_heuristic_initialized)
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  if (!heurdata->initialized)
   {
 #ifdef DEBUG_BAD_FEASIBLE
     SCIPinfoMessage(scip, NULL, "Heuristic from FEASIBLE_SOLUTION: Data not initialized.\\n");
@@ -423,10 +428,10 @@ int bad_feasible_solution(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur)
     return 0;
   }
 
-  if (g_num_heuristic_solution_vars == 0)
+  if (heurdata->nassignments == 0)
   {
 #ifdef DEBUG_BAD_FEASIBLE
-    SCIPinfoMessage(scip, NULL, "Heuristic from FEASIBLE_SOLUTION: No variables were loaded (global list is empty).\\n");
+    SCIPinfoMessage(scip, NULL, "Heuristic from FEASIBLE_SOLUTION: No variables were loaded (list is empty).\\n");
 #endif
     return 0;  // No variables to form a solution
   }
@@ -438,28 +443,22 @@ int bad_feasible_solution(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur)
   I = SCIPprobdataGetInstance(probdata);
   assert(I != NULL);
 
-  /* nvars = SCIPprobdataGetNVars(probdata); // For context if needed, not for array sizing here */
-
-  if (g_num_heuristic_solution_vars > 0)
-  {
-    SCIP_CALL(SCIPallocBufferArray(scip, &vars_for_sol_array, g_num_heuristic_solution_vars));
-  }
+  SCIP_CALL(SCIPallocBufferArray(scip, &vars_for_sol_array, heurdata->nassignments));
 
-  for (i = 0; i < g_num_heuristic_solution_vars; ++i)
+  for (i = 0; i < heurdata->nassignments; ++i)
   {
-    const char *var_name_from_tmp = g_heuristic_solution_var_names[i];
-    current_scip_var              = SCIPfindVar(scip, var_name_from_tmp);
+    int professor = heurdata->professors[i];
+    int course    = heurdata->courses[i];
 
-    if (current_scip_var != NULL)
+    if (professor >= 0 && professor < I->nProfessors && course >= 0 && course < I->nCourses)
     {
-      /* We sized vars_for_sol_array for g_num_heuristic_solution_vars, so this check is always true if var is found */
-      /* and num_vars_added_to_solution will not exceed g_num_heuristic_solution_vars */
-      vars_for_sol_array[num_vars_added_to_solution++] = current_scip_var;
+      /* We sized vars_for_sol_array for nassignments, so num_vars_added_to_solution will not exceed it */
+      vars_for_sol_array[num_vars_added_to_solution++] = SCIPprobdataGetVarByIndex(probdata, professor, course);
     }
     else
     {
 #ifdef DEBUG_BAD_FEASIBLE
-      SCIPinfoMessage(scip, NULL, "Heuristic from FEASIBLE_SOLUTION: Variable '%s' (from global list) not found in SCIP problem.\\n", var_name_from_tmp);
+      SCIPinfoMessage(scip, NULL, "Heuristic from FEASIBLE_SOLUTION: Variable 'x_%d_%d' not found in SCIP problem.\\n", professor, course);
 #endif
     }
   }
@@ -558,8 +557,12 @@ SCIP_RETCODE SCIPincludeHeurBadFeasibleSolution(
   SCIP_HEURDATA *heurdata;
   SCIP_HEUR *heur;
 
-  /* create rounding primal heuristic data */
-  heurdata = NULL;
+  /* create badFeasible primal heuristic data */
+  SCIP_CALL(SCIPallocMemory(scip, &heurdata));
+  heurdata->professors   = NULL;
+  heurdata->courses      = NULL;
+  heurdata->nassignments = 0;
+  heurdata->initialized  = FALSE;
 
   heur     = NULL;
 
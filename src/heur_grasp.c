@@ -22,16 +22,45 @@
 
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 #include "heur_grasp.h"
+#include "event_interrupt.h"
 #include "heur_problem.h"
+#include "localsearch_dpd.h"
 #include "parameters_dpd.h"
 #include "probdata_dpd.h"
 #include "problem.h"
+#include "rng_dpd.h"
+#include "score_dpd.h"
+#include "zobrist_dpd.h"
 
 //#define DEBUG_GRASP 1
+#define ARENA_ALIGN 16 /* alignment of the blocks of a GraspArena */
+#define ARENA_ROUND(size) (((size) + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1))
+
+/* reactive GRASP (--grasp_reactive 1) */
+#define GRASP_NALPHAS 10            /**< alpha values of reactive GRASP: 0.1, 0.2, ..., 1.0 */
+#define GRASP_REACTIVE_PERIOD 10    /**< iterations of a worker between two updates of its alpha probabilities */
+#define GRASP_REACTIVE_DELTA 10.0   /**< exponent that amplifies the differences of quality between alpha values */
+#define GRASP_REACTIVE_MINPROB 0.01 /**< minimal probability of an alpha value, so every value is still sampled */
+
+/* elite pool and path relinking (--grasp_path_relinking 1) */
+#define GRASP_ELITE_SIZE 10         /**< maximal number of solutions of an elite pool */
+#define GRASP_ELITE_MINDIFF 0.05    /**< a new elite solution differs from the others in at least this fraction of the courses */
+#define GRASP_POOL_KEEP 0.5         /**< probability of keeping each assignment of a pool solution in a seeded construction */
+#define GRASP_RECENT_LOG2 12        /**< the set of assignments already sent to SCIP has 2^12 slots */
+
+/* adaptive scheduling (--grasp_adaptive 1) */
+#define GRASP_SCHED_MAXBACKOFF 64   /**< maximal number of calls skipped after an unproductive execution */
+#define GRASP_SCHED_SHARE 0.05      /**< executions are not backed off while GRASP used at most this share of the solving time */
+#define GRASP_SCHED_BOUNDMOVE 0.1   /**< a dual bound move that closes this fraction of the gap re-enables GRASP */
+
+/* LP-guided construction (--grasp_lp_guided 1) */
+#define GRASP_LP_SCALE 1000.0       /**< blended scores in [0,1] are scaled to integers of the RCL with this factor */
 /* configuracao da heuristica */
 #define HEUR_NAME "grasp"
 #define HEUR_DESC "grasp primal heuristic template"
@@ -53,18 +82,124 @@
  * Data structures
  */
 
-/* TODO: fill in the necessary primal heuristic data */
+/** statistics of reactive GRASP: quality of the solutions built with each alpha value */
+typedef struct
+{
+  double sum[GRASP_NALPHAS];  /**< sum of the objective values of the feasible solutions built with each alpha */
+  int count[GRASP_NALPHAS];   /**< number of feasible solutions built with each alpha */
+  int nfail[GRASP_NALPHAS];   /**< number of incomplete or infeasible solutions built with each alpha (valued as worst) */
+  double prob[GRASP_NALPHAS]; /**< probability of choosing each alpha */
+  double best;                /**< best objective value seen */
+  double worst;               /**< worst objective value seen */
+} ReactiveT;
+
+/** pool of elite solutions: distinct high-quality assignments (professor of each course) */
+typedef struct
+{
+  int *assign;              /**< assignments of the members (member k at assign[k * m .. k * m + m - 1]) */
+  double *value;            /**< objective value of each member */
+  uint64_t *hash;           /**< Zobrist hash of the assignment of each member */
+  int *known;               /**< 1 if the member was already relinked in a previous call */
+  int size;                 /**< number of members */
+  int capacity;             /**< maximal number of members */
+  int m;                    /**< number of courses */
+  int mindiff;              /**< minimal number of courses in which a member differs from the others */
+  const ZobristT *zobrist;  /**< keys of the hashes */
+} ElitePoolT;
 
 /** primal heuristic data */
-/*struct SCIP_HeurData
+struct SCIP_HeurData
 {
+  parametersT param;          /**< parameters of the solve (GRASP iterations, alpha, reactive mode, local search and threads) */
+  GraspGraph graph;           /**< professor-course graph of the instance (built in heurInitGrasp) */
+  int graph_built;            /**< 1 if graph holds the graph of the current instance */
+  GraspArena callarena;       /**< memory of one call: workers, fixed variables and per-worker solution state */
+  GraspArena *arenas;         /**< scratch memory of each worker, reset at every iteration */
+  LocalSearchT **ls;          /**< local search of each worker */
+  int nthreads;               /**< number of workers (and arenas) */
+  ReactiveT reactive;         /**< alpha distribution learned by reactive GRASP, kept across the calls of a solve */
+  GraspArena poolarena;       /**< memory of pool */
+  ElitePoolT pool;            /**< best distinct assignments of all calls of the solve (--grasp_elite_pool 1) */
+  RngT rng;                   /**< random stream of the heuristic, seeded from --seed in heurInitGrasp */
+  ZobristT *zobrist;          /**< keys of the hashes of the assignments */
+  RecentSetT *recent;         /**< assignments already sent to SCIP by the calls of the solve */
+  int skip;                   /**< calls still to be skipped (--grasp_adaptive 1) */
+  int backoff;                /**< calls skipped after the next unproductive execution (doubles up to GRASP_SCHED_MAXBACKOFF) */
+  SCIP_Real sched_upper;      /**< primal bound (transformed problem) after the last execution */
+  SCIP_Real sched_lower;      /**< dual bound (transformed problem) at the last execution */
+  SCIP_Real exectime;         /**< time spent in the executions of the solve */
+  SCIP_Longint nskipped;      /**< calls skipped by the adaptive scheduling */
+  SCIP_Longint nresets;       /**< times the backoff was reset by a new incumbent or a dual bound move */
+  int *resume_assign;         /**< pool members of a checkpoint, loaded into pool by heurInitGrasp (nresume x nCourses) */
+  double *resume_value;       /**< objective value of each member of resume_assign */
+  int nresume;                /**< number of members of resume_assign */
 };
-*/
+
+/** data shared (read-only) by the GRASP workers of one call */
+typedef struct
+{
+  SCIP *scip;               /**< SCIP data structure (only read by the workers) */
+  SCIP_PROBDATA *probdata;  /**< problem data (only read by the workers) */
+  SCIP_VAR **varlist;       /**< array of all variables */
+  const double *weight;     /**< objective coefficient of x_p_c at p * m + c (original space, maximized) */
+  Instance *I;              /**< instance */
+  GraspGraph *graph;        /**< professor-course graph of the node (edges fixed to 0 at the node removed) */
+  ScoreKernelT score;       /**< candidate scoring kernel (AVX2 or scalar) */
+  float alpha;              /**< RCL parameter (fixed alpha) */
+  int reactive;             /**< 1 = choose alpha at each iteration from the reactive distribution */
+  int use_local_search;     /**< 1 = run local search after each construction */
+  LS_Strategy ls_strategy;  /**< first or best improvement */
+  int ls_neighborhoods;     /**< neighborhoods of the local search (LS_SHIFT | LS_SWAP | LS_EJECTION) */
+  int path_relinking;       /**< 1 = keep elite solutions and relink them at the end of the call */
+  ElitePoolT *pool;         /**< persistent pool of the heuristic (NULL = not used); read-only during the call */
+  const ZobristT *zobrist;  /**< keys of the hashes of the assignments */
+  const RecentSetT *recent; /**< assignments already sent to SCIP by previous calls; read-only during the call */
+  int nthreads;             /**< number of workers */
+  char *forbidden;          /**< forbidden[p * m + c] = 1 if x_p_c has local upper bound 0 */
+  char *locked;             /**< locked[c] = 1 if course c is fixed to a professor at the node */
+  double *lpval;            /**< LP value of x_p_c at p * m + c (NULL = construction not guided by the LP) */
+  int *lp_prof;             /**< professor of each course whose LP solution is integral (-1 = fractional) */
+  double lp_weight;         /**< weight of the LP value in the blended score (the greedy score gets 1 - lp_weight) */
+  int *fixed_prof;          /**< professor of each variable fixed to 1 at the node */
+  int *fixed_course;        /**< course of each variable fixed to 1 at the node */
+  int nFixed;               /**< number of variables fixed to 1 */
+  SCIP_Real node_bound;     /**< dual bound of the node (original space): no solution of its subtree is better */
+} GraspSharedT;
+
+/** state of one GRASP worker: everything an iteration writes is owned by its worker */
+typedef struct
+{
+  int id;                      /**< index of the worker */
+  GraspArena *scratch;         /**< scratch memory of the iterations of the worker */
+  LocalSearchT *ls;            /**< local search of the worker */
+  GraspSharedT *shared;        /**< read-only data of the call */
+  int niterations;             /**< number of iterations of this worker */
+  RngT rng;                    /**< random stream of the worker (a jump of the stream of the call) */
+  ProfessorAux *profs_aux;     /**< workloads and degrees of the professors */
+  CourseAux *courses_aux;      /**< state of the courses */
+  int *best_assign;            /**< best feasible assignment of the worker (professor of each course) */
+  int found;                   /**< 1 if best_assign holds a solution */
+  SCIP_Real best_obj_value;    /**< objective value of best_assign */
+  uint64_t best_hash;          /**< Zobrist hash of best_assign */
+  ReactiveT reactive;          /**< reactive statistics of the worker (the distribution of the call plus its own iterations) */
+  ElitePoolT elite;            /**< elite solutions of the worker (path relinking) */
+  int *assign;                 /**< professor of each course in the solution of the current iteration */
+} GraspWorkerT;
+
 /*
  * Local methods
  */
 
 /* put your local methods here, and declare them static */
+int build_grasp_graph(Instance *I, GraspGraph *graph);
+void free_grasp_graph(GraspGraph *graph);
+int build_node_graph(const GraspGraph *graph, const char *forbidden, int n, int m, GraspGraph *node, GraspArena *arena);
+size_t grasp_iteration_bytes(int n, int m);
+size_t grasp_call_bytes(int n, int m, int nedges, int nthreads);
+size_t elite_bytes(int capacity, int m);
+int elite_init(ElitePoolT *pool, GraspArena *arena, int capacity, int m, const ZobristT *zobrist);
+int elite_insert(ElitePoolT *pool, const int *assign, double value);
+void reactive_reset(ReactiveT *reactive);
 
 /*
  * Callback methods of primal heuristic
@@ -82,6 +217,15 @@ static SCIP_DECL_HEURCOPY(heurCopyGrasp)
 /** destructor of primal heuristic to free user data (called when SCIP is exiting) */
 static SCIP_DECL_HEURFREE(heurFreeGrasp)
 { /*lint --e{715}*/
+  SCIP_HEURDATA *heurdata;
+
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  SCIPfreeMemoryArrayNull(scip, &heurdata->resume_assign);
+  SCIPfreeMemoryArrayNull(scip, &heurdata->resume_value);
+  SCIPfreeMemory(scip, &heurdata);
+  SCIPheurSetData(heur, NULL);
 
   return SCIP_OKAY;
 }
@@ -89,6 +233,97 @@ static SCIP_DECL_HEURFREE(heurFreeGrasp)
 /** initialization method of primal heuristic (called after problem was transformed) */
 static SCIP_DECL_HEURINIT(heurInitGrasp)
 { /*lint --e{715}*/
+  SCIP_HEURDATA *heurdata;
+  SCIP_PROBDATA *probdata;
+  Instance *I;
+  size_t size;
+
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  heurdata->graph_built    = 0;
+  heurdata->arenas         = NULL;
+  heurdata->ls             = NULL;
+  heurdata->nthreads       = 0;
+  heurdata->callarena.base = NULL;
+  heurdata->poolarena.base = NULL;
+  heurdata->pool.size      = 0;
+  heurdata->zobrist        = NULL;
+  heurdata->recent         = NULL;
+  reactive_reset(&heurdata->reactive);
+  rngSeed(&heurdata->rng, (uint64_t) heurdata->param.seed, RNG_STREAM_GRASP);
+  heurdata->skip          = 0;
+  heurdata->backoff       = 1;
+  heurdata->sched_upper   = SCIPinfinity(scip);
+  heurdata->sched_lower   = -SCIPinfinity(scip);
+  heurdata->exectime      = 0.0;
+  heurdata->nskipped      = 0;
+  heurdata->nresets       = 0;
+
+  probdata = SCIPgetProbData(scip);
+  if (probdata == NULL)
+    return SCIP_OKAY;
+  I = SCIPprobdataGetInstance(probdata);
+
+  // the graph and the memory of the heuristic only depend on the instance: set them up once per solve
+  if (!build_grasp_graph(I, &heurdata->graph))
+  {
+    free_grasp_graph(&heurdata->graph);
+    return SCIP_NOMEMORY;
+  }
+  heurdata->graph_built = 1;
+
+  // duplicate detection: Zobrist keys of the pairs (professor, course) and the assignments already sent to SCIP
+  heurdata->zobrist = zobristCreate(I->nProfessors, I->nCourses, (uint64_t) heurdata->param.seed);
+  heurdata->recent  = recentCreate(GRASP_RECENT_LOG2);
+  if (heurdata->zobrist == NULL || heurdata->recent == NULL)
+    return SCIP_NOMEMORY;
+
+  heurdata->nthreads = heurdata->param.grasp_threads < heurdata->param.grasp_max_iter ? heurdata->param.grasp_threads : heurdata->param.grasp_max_iter;
+  size               = grasp_call_bytes(I->nProfessors, I->nCourses, heurdata->graph.prof_start[I->nProfessors], heurdata->nthreads);
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->callarena.base, size));
+  heurdata->callarena.size = size;
+  heurdata->callarena.used = 0;
+
+  // the persistent pool lives as long as the transformed problem
+  size = elite_bytes(GRASP_POOL_SIZE, I->nCourses);
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->poolarena.base, size));
+  heurdata->poolarena.size = size;
+  heurdata->poolarena.used = 0;
+  elite_init(&heurdata->pool, &heurdata->poolarena, GRASP_POOL_SIZE, I->nCourses, heurdata->zobrist);
+
+  // resume: the pool starts with the members saved in the checkpoint (not relinked yet in this run)
+  if (heurdata->param.grasp_elite_pool)
+  {
+    for (int s = 0; s < heurdata->nresume; s++)
+      elite_insert(&heurdata->pool, &heurdata->resume_assign[s * I->nCourses], heurdata->resume_value[s]);
+  }
+  SCIPfreeMemoryArrayNull(scip, &heurdata->resume_assign);
+  SCIPfreeMemoryArrayNull(scip, &heurdata->resume_value);
+  heurdata->nresume = 0;
+
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->arenas, heurdata->nthreads));
+  size = grasp_iteration_bytes(I->nProfessors, I->nCourses);
+  for (int w = 0; w < heurdata->nthreads; w++)
+  {
+    SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->arenas[w].base, size));
+    heurdata->arenas[w].size = size;
+    heurdata->arenas[w].used = 0;
+  }
+
+  // local search (and native evaluator) of each worker, with the objective coefficients of the original problem
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->ls, heurdata->nthreads));
+  for (int w = 0; w < heurdata->nthreads; w++)
+  {
+    heurdata->ls[w] = NULL;
+  }
+  for (int w = 0; w < heurdata->nthreads; w++)
+  {
+    heurdata->ls[w] = lsCreate(I);
+    if (heurdata->ls[w] == NULL)
+      return SCIP_NOMEMORY;
+    lsSetZobrist(heurdata->ls[w], heurdata->zobrist);
+  }
 
   return SCIP_OKAY;
 }
@@ -96,6 +331,32 @@ static SCIP_DECL_HEURINIT(heurInitGrasp)
 /** deinitialization method of primal heuristic (called before transformed problem is freed) */
 static SCIP_DECL_HEUREXIT(heurExitGrasp)
 { /*lint --e{715}*/
+  SCIP_HEURDATA *heurdata;
+
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  if (heurdata->graph_built)
+    free_grasp_graph(&heurdata->graph);
+  heurdata->graph_built = 0;
+  for (int w = 0; w < heurdata->nthreads; w++)
+  {
+    SCIPfreeMemoryArray(scip, &heurdata->arenas[w].base);
+    if (heurdata->ls != NULL)
+      lsFree(&heurdata->ls[w]);
+  }
+  SCIPfreeMemoryArrayNull(scip, &heurdata->ls);
+  SCIPfreeMemoryArrayNull(scip, &heurdata->arenas);
+  SCIPfreeMemoryArrayNull(scip, &heurdata->callarena.base);
+  SCIPfreeMemoryArrayNull(scip, &heurdata->poolarena.base);
+  zobristFree(&heurdata->zobrist);
+  recentFree(&heurdata->recent);
+  heurdata->arenas         = NULL;
+  heurdata->ls             = NULL;
+  heurdata->callarena.base = NULL;
+  heurdata->poolarena.base = NULL;
+  heurdata->pool.size      = 0;
+  heurdata->nthreads       = 0;
 
   return SCIP_OKAY;
 }
@@ -114,16 +375,45 @@ static SCIP_DECL_HEUREXITSOL(heurExitsolGrasp)
   return SCIP_OKAY;
 }
 
-// reset level of each course
-void reset_course_level(CourseAux *courses_aux, int m)
+// allocate size bytes from the arena (NULL if it is full)
+void *arena_alloc(GraspArena *arena, size_t size)
 {
-  for (int t = 0; t < m; t++)
-  {
-    courses_aux[t].course->level = 0;
-  }
+  size_t start = arena->used;
+
+  size         = ARENA_ROUND(size);
+  if (start + size > arena->size)
+    return NULL;
+  arena->used += size;
+  return arena->base + start;
+}
+
+// bytes of scratch memory used by one iteration (construct_solution) of a worker
+size_t grasp_iteration_bytes(int n, int m)
+{
+  return ARENA_ROUND(sizeof(CourseAux) * m) + ARENA_ROUND(sizeof(PreferenceAux) * n) + ARENA_ROUND(sizeof(int) * (n + 1)) +
+         2 * ARENA_ROUND(sizeof(int) * m) +
+         3 * ARENA_ROUND(sizeof(double) * n) + ARENA_ROUND(sizeof(int) * n) +  // candidate arrays of the scoring kernel
+         3 * ARENA_ROUND(sizeof(int) * n);                                     // minimum-workload repair
+}
+
+// bytes of memory used by one call of grasp() with nthreads workers (nedges = number of edges of the graph of the instance)
+size_t grasp_call_bytes(int n, int m, int nedges, int nthreads)
+{
+  size_t elite = elite_bytes(GRASP_ELITE_SIZE, m);
+
+  return ARENA_ROUND(sizeof(GraspWorkerT) * nthreads) + ARENA_ROUND(sizeof(pthread_t) * nthreads) + 2 * ARENA_ROUND(sizeof(int) * (m + 1)) +
+         nthreads * (ARENA_ROUND(sizeof(ProfessorAux) * n) + ARENA_ROUND(sizeof(CourseAux) * m) + ARENA_ROUND(sizeof(int) * m) +
+                     elite + ARENA_ROUND(sizeof(int) * m)) +
+         elite_bytes(GRASP_ELITE_SIZE + GRASP_POOL_SIZE, m) + 3 * ARENA_ROUND(sizeof(int) * m) + 2 * ARENA_ROUND(sizeof(int) * n) +
+         ARENA_ROUND(sizeof(int) * m) +                                                     // path relinking
+         ARENA_ROUND(sizeof(char) * n * m) +                                                // forbidden variables
+         ARENA_ROUND(sizeof(double) * n * m) + ARENA_ROUND(sizeof(int) * m) +               // LP values, courses with integral LP value
+         ARENA_ROUND(sizeof(char) * m) +                                                    // locked courses
+         ARENA_ROUND(sizeof(int) * (n + 1)) + ARENA_ROUND(sizeof(int) * (m + 1)) +          // graph of the node
+         2 * ARENA_ROUND(sizeof(int) * (nedges + 1)) + ARENA_ROUND(sizeof(double) * (nedges + 1));
 }
 
-int random_number(int a, int b)
+int random_number(int a, int b, RngT *rng)
 {
   if (a > b)
   {
@@ -132,7 +422,7 @@ int random_number(int a, int b)
     b        = temp;
   }
 
-  return a + rand() % (b - a + 1);
+  return rngInt(rng, a, b);
 }
 
 // calculate the score of the edges
@@ -141,14 +431,6 @@ int calculaScore(int peso_preferencia, int alfa)
   return peso_preferencia + alfa * 1;
 }
 
-// compare level of two courses
-int compareCourses(const void *a, const void *b)
-{
-  const CourseAux *courseA = (const CourseAux *) a;
-  const CourseAux *courseB = (const CourseAux *) b;
-  return (courseA->course->level - courseB->course->level);
-}
-
 // compare level of two professors
 int compareProfessoresByLevel(const void *a, const void *b)
 {
@@ -175,102 +457,170 @@ double check_preference_weight(Preference *preferences, int num_preferences, int
   return preferences[course_label].weight;
 }
 
-// create the edges between professors and courses
-void adaptive_edges(ProfessorAux *profs_aux, CourseAux *courses_aux, int n, int m)
+// create the edges between professors and courses: a professor can teach a course with a preference weight or in one of its areas
+int build_grasp_graph(Instance *I, GraspGraph *graph)
 {
+  int n = I->nProfessors;
+  int m = I->nCourses;
+  int nedges, e;
   double peso;
-  int score, n_pref;
 
-  /*idea:
-  1° compute degrees (professors possible assignments and courses possible professors)
-  2° for each feasible (prof, course) pair compute a score that favors low degree vertices
-    for that: use a formula that combines the original preference weight with inverse degree terms
-  */
+  graph->prof_start   = (int *) malloc(sizeof(int) * (n + 1));
+  graph->course_start = (int *) calloc(m + 1, sizeof(int));
+  graph->prof_course  = NULL;
+  graph->course_prof  = NULL;
+  graph->course_base  = NULL;
+  if (graph->prof_start == NULL || graph->course_start == NULL)
+    return 0;
 
-  // zero degrees and temp counts
+  // 1°: count the edges of each vertex
+  nedges = 0;
   for (int p = 0; p < n; p++)
   {
-    profs_aux[p].n = 0;
+    Professor *prof      = &I->professors[p];
+    graph->prof_start[p] = nedges;
+    for (int t = 0; t < m; t++)
+    {
+      peso = check_preference_weight(prof->preferences, m, t);
+      if (peso > EPSILON || check_area_bitmask(prof->areas, I->courses[t].subject.areas) == 1)
+      {
+        nedges++;
+        graph->course_start[t + 1]++;
+      }
+    }
   }
+  graph->prof_start[n] = nedges;
   for (int t = 0; t < m; t++)
-  {
-    courses_aux[t].course->level = 0;
-  }
-
-  // 1°: count possible edges (degrees) without setting preference list
+    graph->course_start[t + 1] += graph->course_start[t];
+
+  graph->prof_course = (int *) malloc(sizeof(int) * (nedges + 1));
+  graph->course_prof = (int *) malloc(sizeof(int) * (nedges + 1));
+  graph->course_base = (double *) malloc(sizeof(double) * (nedges + 1));
+  if (graph->prof_course == NULL || graph->course_prof == NULL || graph->course_base == NULL)
+    return 0;
+
+  // 2°: fill both adjacency lists (professors in increasing label in each course list)
+  int *fill = (int *) malloc(sizeof(int) * (m + 1));
+  if (fill == NULL)
+    return 0;
+  memcpy(fill, graph->course_start, sizeof(int) * (m + 1));
+  e = 0;
   for (int p = 0; p < n; p++)
   {
-    Professor *prof = profs_aux[p].professor;
+    Professor *prof = &I->professors[p];
     for (int t = 0; t < m; t++)
     {
-      if (courses_aux[t].covered == 1) continue;
-      Course *course = courses_aux[t].course;
-
-      peso           = check_preference_weight(prof->preferences, m, course->label);
-      if (peso > EPSILON)
-      {
-        profs_aux[p].n++;
-        courses_aux[t].course->level++;
-      }
-      else if (check_area_bitmask(prof->areas, course->subject.areas) == 1)
+      peso = check_preference_weight(prof->preferences, m, t);
+      if (peso > EPSILON || check_area_bitmask(prof->areas, I->courses[t].subject.areas) == 1)
       {
-        profs_aux[p].n++;
-        courses_aux[t].course->level++;
+        graph->prof_course[e++]         = t;
+        graph->course_prof[fill[t]]     = p;
+        graph->course_base[fill[t]++]   = peso > EPSILON ? peso : 1.0;  // small base weight for area-based edges
       }
     }
   }
+  free(fill);
+  return 1;
+}
+
+void free_grasp_graph(GraspGraph *graph)
+{
+  free(graph->prof_start);
+  free(graph->prof_course);
+  free(graph->course_start);
+  free(graph->course_prof);
+  free(graph->course_base);
+}
 
-  // 2°: fill pref lists and compute scores using degrees
-  const double K = 5.0; /* weight factor to amplify inverse-degree effect */
+/**
+ * candidate index of a node: the edges of graph whose variable is not fixed to 0 at the node (forbidden[p * m + c] = 0),
+ * in the same order, in arrays of the arena. Returns the number of edges removed.
+ */
+int build_node_graph(const GraspGraph *graph, const char *forbidden, int n, int m, GraspGraph *node, GraspArena *arena)
+{
+  int nedges = graph->prof_start[n];
+  int e, k;
+
+  node->prof_start   = (int *) arena_alloc(arena, sizeof(int) * (n + 1));
+  node->prof_course  = (int *) arena_alloc(arena, sizeof(int) * (nedges + 1));
+  node->course_start = (int *) arena_alloc(arena, sizeof(int) * (m + 1));
+  node->course_prof  = (int *) arena_alloc(arena, sizeof(int) * (nedges + 1));
+  node->course_base  = (double *) arena_alloc(arena, sizeof(double) * (nedges + 1));
+  assert(node->prof_start != NULL && node->prof_course != NULL && node->course_start != NULL);
+  assert(node->course_prof != NULL && node->course_base != NULL);  // the arena is sized by grasp_call_bytes
+
+  k = 0;
   for (int p = 0; p < n; p++)
   {
-    Professor *prof = profs_aux[p].professor;
-    n_pref          = 0;  // index to fill profs_aux[p].pref
-
-    // if no possible courses, ensure n is zero
-    if (profs_aux[p].n == 0)
+    node->prof_start[p] = k;
+    for (e = graph->prof_start[p]; e < graph->prof_start[p + 1]; e++)
     {
-      profs_aux[p].n = 0;
-      continue;
+      if (!forbidden[p * m + graph->prof_course[e]])
+        node->prof_course[k++] = graph->prof_course[e];
     }
+  }
+  node->prof_start[n] = k;
 
-    for (int t = 0; t < m; t++)
+  k = 0;
+  for (int t = 0; t < m; t++)
+  {
+    node->course_start[t] = k;
+    for (e = graph->course_start[t]; e < graph->course_start[t + 1]; e++)
     {
-      if (courses_aux[t].covered == 1) continue;
-      Course *course = courses_aux[t].course;
-
-      peso           = check_preference_weight(prof->preferences, m, course->label);
-      if (peso > EPSILON)
-      {
-        // combine base preference with inverse-degree bonuses
-        double degp                            = (double) profs_aux[p].n;                // level of the current professor
-        double degt                            = (double) courses_aux[t].course->level;  // level of the current course
-        double base                            = peso;
-        double bonus                           = K * (1.0 / (1.0 + degp) + 1.0 / (1.0 + degt));
-        score                                  = (int) ceil(base * (1.0 + bonus));
-
-        profs_aux[p].pref[n_pref].course_label = course->label;
-        profs_aux[p].pref[n_pref].score        = score;
-        n_pref++;
-      }
-      else if (check_area_bitmask(prof->areas, course->subject.areas) == 1)
-      {
-        double degp                            = (double) profs_aux[p].n;                // level of the current professor
-        double degt                            = (double) courses_aux[t].course->level;  // level of the current course
-        double base                            = 1.0;                                    // small base weight for area-based edges
-        double bonus                           = K * (1.0 / (1.0 + degp) + 1.0 / (1.0 + degt));
-        score                                  = (int) ceil(base * (1.0 + bonus));
-
-        profs_aux[p].pref[n_pref].course_label = course->label;
-        profs_aux[p].pref[n_pref].score        = score;
-        n_pref++;
-      }
+      if (forbidden[graph->course_prof[e] * m + t]) continue;
+      node->course_prof[k]   = graph->course_prof[e];
+      node->course_base[k++] = graph->course_base[e];
     }
-    profs_aux[p].n = n_pref;  // update actual filled count
   }
+  node->course_start[m] = k;
+  return nedges - k;
+}
+
+// check if the professor still has capacity for the course in its semester
+int has_capacity(ProfessorAux *prof_aux, Course *course)
+{
+  if (course->semester == 1)
+    return prof_aux->current_CH1 + course->workload <= prof_aux->professor->maxWorkload1;
+  return prof_aux->current_CH2 + course->workload <= prof_aux->professor->maxWorkload2;
+}
+
+// bucket priority queue of the uncovered courses, keyed by their level (number of professors that can still teach them)
+void bucket_insert(BucketQueue *queue, int course, int level)
+{
+  queue->prev[course] = -1;
+  queue->next[course] = queue->head[level];
+  if (queue->head[level] >= 0)
+    queue->prev[queue->head[level]] = course;
+  queue->head[level] = course;
+  if (level < queue->min)
+    queue->min = level;
+}
+
+void bucket_remove(BucketQueue *queue, int course, int level)
+{
+  if (queue->prev[course] >= 0)
+    queue->next[queue->prev[course]] = queue->next[course];
+  else
+    queue->head[level] = queue->next[course];
+  if (queue->next[course] >= 0)
+    queue->prev[queue->next[course]] = queue->prev[course];
+}
+
+// remove and return the most constrained course (-1 if the queue is empty)
+int bucket_pop_min(BucketQueue *queue)
+{
+  int course;
+
+  while (queue->min <= queue->maxlevel && queue->head[queue->min] < 0)
+    queue->min++;
+  if (queue->min > queue->maxlevel)
+    return -1;
+  course = queue->head[queue->min];
+  bucket_remove(queue, course, queue->min);
+  return course;
 }
 
-int grasp_randomized_selection(PreferenceAux *candidates, int num_candidates, float alpha)
+int grasp_randomized_selection(PreferenceAux *candidates, int num_candidates, float alpha, RngT *rng)
 {
   if (num_candidates == 1) return 0;
 
@@ -297,656 +647,1114 @@ int grasp_randomized_selection(PreferenceAux *candidates, int num_candidates, fl
     }
   }
 
-  if (rcl_size == 0) return rand() % num_candidates;
+  if (rcl_size == 0) return rngInt(rng, 0, num_candidates - 1);
 
-  return rcl[rand() % rcl_size];
+  return rcl[rngInt(rng, 0, rcl_size - 1)];
 }
 
-void construct_solution(
-        SCIP *scip,               // SCIP instance
-        SCIP_VAR **varlist,       // array of all variables
-        SCIP_VAR **solution,      // outupt sulution array
-        ProfessorAux *profs_aux,  // auxiliar professor structures
-        CourseAux *courses_aux,   // auxiliar course structures
-        int *nInSolution,         // number of variables in solution
-        int *nCovered,            // number of covered couses
-        int m,                    // number of couses
-        int n,                    // number of professors
-        float alpha)
+// 1 if course fits in the semester workload of professor prof after prof gives away course out (NULL = none)
+int fits_after(ProfessorAux *prof, Course *course, Course *out)
 {
+  int load = course->semester == 1 ? prof->current_CH1 : prof->current_CH2;
+  int max  = course->semester == 1 ? prof->professor->maxWorkload1 : prof->professor->maxWorkload2;
 
-  CourseAux *courses_sem_profs       = (CourseAux *) malloc(sizeof(CourseAux) * m);  // buffer sized to m
-  int n_sem_prof                     = 0, num_candidates, prof_label;
+  if (out != NULL && out->semester == course->semester) load -= out->workload;
+  return load + course->workload <= max;
+}
 
-  // track assigned variable per course label (index = label)
-  SCIP_VAR **assigned_var_for_course = (SCIP_VAR **) calloc(m, sizeof(SCIP_VAR *));
-  for (int i = 0; i < m; i++)
-  {
-    assigned_var_for_course[i] = NULL;
-  }
+/*
+ * minimum-workload repair. For each professor q below minWorkload, a breadth-first search over the professors finds
+ * a shortest chain of course moves q <- p1 <- p2 <- ... <- pk: each professor gives one course to the previous one,
+ * every receiver keeps its semester maxima, every intermediate professor keeps at least minWorkload, and pk (the
+ * donor) stays at or above minWorkload after losing its course. Applying the chain increases the workload of q and
+ * no other professor falls below its minimum, so the search is repeated until q is repaired or no chain exists.
+ * This is the augmenting path method of max-flow, with courses as the units moved between professors.
+ * Returns the number of professors still below minWorkload.
+ */
+int repair_min_workload(
+        ProfessorAux *profs_aux,  // workloads of the professors (updated)
+        CourseAux *courses_aux,   // professor of each course (updated; -1 = not assigned)
+        int n,                    // number of professors
+        int m,                    // number of courses
+        const char *forbidden,    // forbidden[p * m + c] = 1 if course c may not be given to professor p
+        const char *locked,       // locked[c] = 1 if course c keeps its professor
+        GraspArena *scratch)      // memory of parent, out and queue
+{
+  int *parent = (int *) arena_alloc(scratch, sizeof(int) * n);  // professor that receives the course of p (-1 = root, -2 = not visited)
+  int *out    = (int *) arena_alloc(scratch, sizeof(int) * n);  // course given away by p in the chain
+  int *queue  = (int *) arena_alloc(scratch, sizeof(int) * n);
+  int q, p, c, head, tail, donor, nunder = 0;
 
-  // build mapping label -> CourseAux* (courses_aux array may be reordered with qsort)
-  CourseAux **course_by_label = (CourseAux **) malloc(sizeof(CourseAux *) * m);
-  for (int idx = 0; idx < m; idx++)
+  assert(parent != NULL && out != NULL && queue != NULL);
+  for (q = 0; q < n; q++)
   {
-    course_by_label[idx] = NULL;
-  }
-  while (*nCovered < m)
-  {
-    int t;
-    for (t = 0; t < m; t++)
+    while (profs_aux[q].current_CH1 + profs_aux[q].current_CH2 < profs_aux[q].professor->minWorkload)
     {
-      CourseAux course_aux            = courses_aux[t];
-      Course *course                  = course_aux.course;
-      PreferenceAux *candidate_scores = (PreferenceAux *) malloc(sizeof(PreferenceAux) * n);
-      SCIP_VAR **candidate_vars       = (SCIP_VAR **) malloc(sizeof(SCIP_VAR *) * n);
-      num_candidates                  = 0;  // number of the candidates professors for the current course
-
-      for (int p = 0; p < n; p++)
+      for (p = 0; p < n; p++)
+        parent[p] = -2;
+      parent[q]     = -1;
+      out[q]        = -1;
+      head          = 0;
+      tail          = 0;
+      queue[tail++] = q;
+      donor         = -1;
+      while (head < tail && donor < 0)
       {
-        prof_label = profs_aux[p].professor->label;
+        p             = queue[head++];
+        Course *given = out[p] >= 0 ? courses_aux[out[p]].course : NULL;
+        int total     = profs_aux[p].current_CH1 + profs_aux[p].current_CH2;
 
-        for (int s = 0; s < profs_aux[p].n && profs_aux[p].pref[s].course_label <= course->label; s++)
+        for (c = 0; c < m && donor < 0; c++)
         {
+          int owner      = courses_aux[c].current_prof;
+          Course *course = courses_aux[c].course;
 
-          if (course->label == profs_aux[p].pref[s].course_label)
-          {
-            if (course->semester == 1)
-            {
-
-              if (profs_aux[p].professor->current_CH1 + course->workload <= profs_aux[p].professor->maxWorkload1)
-              {
-                candidate_scores[num_candidates].course_label = p;
-                candidate_scores[num_candidates].score        = profs_aux[p].pref[s].score;
-                candidate_vars[num_candidates]                = varlist[prof_label * m + course->label];
-                num_candidates++;
-              }
-            }
-            else
-            {
-              if (profs_aux[p].professor->current_CH2 + course->workload <= profs_aux[p].professor->maxWorkload2)
-              {
-                candidate_scores[num_candidates].course_label = p;
-                candidate_scores[num_candidates].score        = profs_aux[p].pref[s].score;
-                candidate_vars[num_candidates]                = varlist[prof_label * m + course->label];
-                num_candidates++;
-              }
-            }
-            break;
-          }
+          if (owner < 0 || parent[owner] != -2 || locked[c] || forbidden[p * m + c]) continue;
+          if (!fits_after(&profs_aux[p], course, given)) continue;
+          if (given != NULL && total - given->workload + course->workload < profs_aux[p].professor->minWorkload) continue;
+
+          parent[owner] = p;
+          out[owner]    = c;
+          if (profs_aux[owner].current_CH1 + profs_aux[owner].current_CH2 - course->workload >= profs_aux[owner].professor->minWorkload)
+            donor = owner;
+          else
+            queue[tail++] = owner;
         }
       }
+      if (donor < 0) break;  // q cannot be repaired
 
-      if (num_candidates > 0)
+      // apply the chain: every professor on the path gives its course to its parent
+      for (p = donor; parent[p] >= 0; p = parent[p])
       {
-        int selected                           = grasp_randomized_selection(candidate_scores, num_candidates, alpha);
-        int p                                  = candidate_scores[selected].course_label;
-
-        // register provisional assignment into mapping (we will rebuild solution list later)
-        assigned_var_for_course[course->label] = candidate_vars[selected];
-        courses_aux[t].covered                 = 1;
-        courses_aux[t].current_prof            = p;
-        (*nCovered)++;
-
+        Course *course = courses_aux[out[p]].course;
         if (course->semester == 1)
         {
-          profs_aux[p].professor->current_CH1 += course->workload;
+          profs_aux[p].current_CH1         -= course->workload;
+          profs_aux[parent[p]].current_CH1 += course->workload;
         }
         else
         {
-          profs_aux[p].professor->current_CH2 += course->workload;
+          profs_aux[p].current_CH2         -= course->workload;
+          profs_aux[parent[p]].current_CH2 += course->workload;
         }
-
-        reset_course_level(courses_aux, m);
-        adaptive_edges(profs_aux, courses_aux, n, m);
-        qsort(courses_aux, m, sizeof(CourseAux), compareCourses);  // ordering the courses by the level of the vertex
-      }
-      else
-      {
-        courses_sem_profs[n_sem_prof] = course_aux;
-        n_sem_prof++;
+        courses_aux[out[p]].current_prof = parent[p];
       }
-
-      free(candidate_scores);
-      free(candidate_vars);
     }
+    if (profs_aux[q].current_CH1 + profs_aux[q].current_CH2 < profs_aux[q].professor->minWorkload) nunder++;
+  }
+  return nunder;
+}
 
-    // create mapping label -> CourseAux*
-    // (courses_aux array was possibly reordered by qsort)
-    for (int idx = 0; idx < m; idx++)
+void construct_solution(
+        GraspGraph *graph,        // professor-course graph of the instance
+        ScoreKernelT score,       // candidate scoring kernel
+        ProfessorAux *profs_aux,  // auxiliar professor structures
+        CourseAux *courses_aux,   // auxiliar course structures (indexed by course label)
+        int *nCovered,            // number of covered couses
+        int m,                    // number of couses
+        int n,                    // number of professors
+        float alpha,              // RCL parameter
+        const double *lpval,      // LP value of each variable (NULL = scores not guided by the LP)
+        const int *lp_prof,       // professor of each course with integral LP value, -1 otherwise (NULL = none)
+        double lp_weight,         // weight of the LP value in the blended score
+        const char *forbidden,    // forbidden[p * m + c] = 1 if course c may not be given to professor p
+        const char *locked,       // locked[c] = 1 if course c keeps its professor (fixed at the node)
+        RngT *rng,                // random stream of the calling worker
+        GraspArena *scratch)      // scratch memory of the calling worker (released by the caller)
+{
+  CourseAux *courses_sem_profs       = (CourseAux *) arena_alloc(scratch, sizeof(CourseAux) * m);  // buffer sized to m
+  PreferenceAux *candidate_scores    = (PreferenceAux *) arena_alloc(scratch, sizeof(PreferenceAux) * n);
+  double *candidate_greedy           = (double *) arena_alloc(scratch, sizeof(double) * n);
+  double *candidate_base             = (double *) arena_alloc(scratch, sizeof(double) * n);
+  double *candidate_degp             = (double *) arena_alloc(scratch, sizeof(double) * n);
+  int *candidate_int                 = (int *) arena_alloc(scratch, sizeof(int) * n);
+  int n_sem_prof                     = 0, num_candidates, prof_label, t, e;
+  double max_greedy;
+  BucketQueue queue;
+
+  queue.head                         = (int *) arena_alloc(scratch, sizeof(int) * (n + 1));
+  queue.next                         = (int *) arena_alloc(scratch, sizeof(int) * m);
+  queue.prev                         = (int *) arena_alloc(scratch, sizeof(int) * m);
+  assert(courses_sem_profs != NULL && candidate_scores != NULL && candidate_greedy != NULL);
+  assert(candidate_base != NULL && candidate_degp != NULL && candidate_int != NULL);
+  assert(queue.head != NULL && queue.next != NULL && queue.prev != NULL);  // the arena is sized by grasp_iteration_bytes
+
+  // the assignment is kept in courses_aux (current_prof, indexed by label); courses already covered (fixed) are kept
+  // LP guidance: courses whose LP solution is integral get that professor first (if it still has capacity)
+  if (lp_prof != NULL)
+  {
+    for (t = 0; t < m; t++)
     {
-      if (courses_aux[idx].course->label >= 0 && courses_aux[idx].course->label < m)
-        course_by_label[courses_aux[idx].course->label] = &courses_aux[idx];
+      int p          = lp_prof[t];
+      Course *course = courses_aux[t].course;
+
+      if (p < 0 || courses_aux[t].covered == 1 || !has_capacity(&profs_aux[p], course)) continue;
+      if (course->semester == 1)
+        profs_aux[p].current_CH1 += course->workload;
+      else
+        profs_aux[p].current_CH2 += course->workload;
+      courses_aux[t].covered      = 1;
+      courses_aux[t].current_prof = p;
+      (*nCovered)++;
     }
+  }
 
-    if (*nCovered < m)
+  /*idea:
+  1° compute degrees once (professors with capacity for each uncovered course, uncovered courses that fit each professor)
+  2° take the most constrained course from a bucket queue, score its candidates from the current degrees, and
+    update only the degrees touched by the assignment
+  */
+  for (int p = 0; p < n; p++)
+  {
+    profs_aux[p].n = 0;
+  }
+  for (t = 0; t < m; t++)
+  {
+    courses_aux[t].level = 0;
+    if (courses_aux[t].covered == 1) continue;
+    for (e = graph->course_start[t]; e < graph->course_start[t + 1]; e++)
     {
-      for (int i = 0; i < n_sem_prof; i++)
+      int p = graph->course_prof[e];
+      if (has_capacity(&profs_aux[p], courses_aux[t].course))
       {
-        int course_label = courses_sem_profs[i].course->label;
-
-        if (courses_sem_profs[i].course->semester == 1)
-        {
-          for (int p = 0; p < n; p++)
-          {
-            prof_label = profs_aux[p].professor->label;
-
-            if (profs_aux[p].professor->current_CH1 + courses_sem_profs[i].course->workload <= profs_aux[p].professor->maxWorkload1)
-            {
-              profs_aux[p].professor->current_CH1 += courses_sem_profs[i].course->workload;
-              assigned_var_for_course[course_label] = varlist[prof_label * m + course_label];
-
-              // update the correct CourseAux using the mapping
-              if (course_by_label[course_label] != NULL)
-              {
-                course_by_label[course_label]->covered      = 1;
-                course_by_label[course_label]->current_prof = prof_label;
-              }
-              (*nCovered)++;
-              break;
-            }
-          }
-        }
-        else
-        {
-
-          for (int p = 0; p < n; p++)
-          {
-            prof_label = profs_aux[p].professor->label;
-
-            if (profs_aux[p].professor->current_CH2 + courses_sem_profs[i].course->workload <= profs_aux[p].professor->maxWorkload2)
-            {
-              profs_aux[p].professor->current_CH2 += courses_sem_profs[i].course->workload;
-              assigned_var_for_course[course_label] = varlist[prof_label * m + course_label];
-
-              // update the correct CourseAux using the mapping
-              if (course_by_label[course_label] != NULL)
-              {
-                course_by_label[course_label]->covered      = 1;
-                course_by_label[course_label]->current_prof = prof_label;
-              }
-              (*nCovered)++;
-              break;
-            }
-          }
-        }
+        profs_aux[p].n++;
+        courses_aux[t].level++;
       }
     }
   }
 
-  // mapping was already created above, but refresh it in case anything changed
-  // (this is now redundant but kept for safety)
-  for (int idx = 0; idx < m; idx++)
+  queue.maxlevel = n;
+  queue.min      = n + 1;
+  for (int l = 0; l <= n; l++)
+  {
+    queue.head[l] = -1;
+  }
+  for (t = 0; t < m; t++)
   {
-    if (courses_aux[idx].course->label >= 0 && courses_aux[idx].course->label < m)
-      course_by_label[courses_aux[idx].course->label] = &courses_aux[idx];
+    if (courses_aux[t].covered == 0)
+      bucket_insert(&queue, t, courses_aux[t].level);
   }
 
-  // repair phase: try to move assigned courses to professors who are below minWorkload without breaking others minWorkload/maxWorkload
-  int repairs = 0;
-  for (int i = 0; i < n; i++)
+  while ((t = bucket_pop_min(&queue)) >= 0)
   {
-    int changed = 0;
-    for (int p = 0; p < n; p++)
+    Course *course = courses_aux[t].course;
+    num_candidates = 0;  // number of the candidates professors for the current course
+    max_greedy     = 0.0;
+
+    // gather the candidates with capacity into contiguous arrays (base preference, degree of the professor)
+    for (e = graph->course_start[t]; e < graph->course_start[t + 1]; e++)
+    {
+      int p = graph->course_prof[e];
+      if (!has_capacity(&profs_aux[p], course)) continue;
+
+      candidate_base[num_candidates]                = graph->course_base[e];
+      candidate_degp[num_candidates]                = (double) profs_aux[p].n;
+      candidate_scores[num_candidates].course_label = p;
+      num_candidates++;
+    }
+
+    // combine base preference with inverse-degree bonuses, for the whole row of candidates at once
+    score(candidate_base, candidate_degp, (double) courses_aux[t].level, num_candidates, candidate_greedy, candidate_int);
+    for (int c = 0; c < num_candidates; c++)
+    {
+      candidate_scores[c].score = candidate_int[c];
+      if (candidate_greedy[c] > max_greedy) max_greedy = candidate_greedy[c];
+    }
+
+    // LP guidance: blend the greedy score (relative to the best candidate) with the LP value of x_p_t
+    if (lpval != NULL && max_greedy > 0.0)
     {
-      int total_workload = profs_aux[p].professor->current_CH1 + profs_aux[p].professor->current_CH2;
-      if (total_workload >= profs_aux[p].professor->minWorkload) continue;
-      // try to find a course j that can be moved to p
-      for (int j = 0; j < m; j++)
+      for (int c = 0; c < num_candidates; c++)
       {
-        SCIP_VAR *varj = assigned_var_for_course[j];
-        if (varj == NULL) continue;
+        int p                     = candidate_scores[c].course_label;
+        double blend              = (1.0 - lp_weight) * candidate_greedy[c] / max_greedy + lp_weight * lpval[p * m + t];
+        candidate_scores[c].score = (int) ceil(GRASP_LP_SCALE * blend);
+      }
+    }
+
+    // a course without candidates has level 0, and no assignment can decrease it, so it is never in the queue again
+    if (num_candidates == 0)
+    {
+      courses_sem_profs[n_sem_prof] = courses_aux[t];
+      n_sem_prof++;
+      continue;
+    }
 
-        CourseAux *ct = course_by_label[j];
-        if (ct == NULL) continue;
+    int selected                = grasp_randomized_selection(candidate_scores, num_candidates, alpha, rng);
+    int p                       = candidate_scores[selected].course_label;
 
-        int owner = ct->current_prof;
-        if (owner == p) continue;
+    // register the assignment (the solution list is built at the end)
+    courses_aux[t].covered      = 1;
+    courses_aux[t].current_prof = p;
+    (*nCovered)++;
 
-        // check semester capacity for p
-        if (ct->course->semester == 1)
-        {
-          if (profs_aux[p].professor->current_CH1 + ct->course->workload > profs_aux[p].professor->maxWorkload1) continue;
-        }
-        else
-        {
-          if (profs_aux[p].professor->current_CH2 + ct->course->workload > profs_aux[p].professor->maxWorkload2) continue;
-        }
+    // the course is covered: it leaves the degree of every professor that could still teach it
+    for (int c = 0; c < num_candidates; c++)
+    {
+      profs_aux[candidate_scores[c].course_label].n--;
+    }
 
-        // ensure owner wont fall below minWorkload after removing this course
-        int owner_total = profs_aux[owner].professor->current_CH1 + profs_aux[owner].professor->current_CH2;
-        if (owner_total - ct->course->workload < profs_aux[owner].professor->minWorkload) continue;
+    if (course->semester == 1)
+      profs_aux[p].current_CH1 += course->workload;
+    else
+      profs_aux[p].current_CH2 += course->workload;
 
-        // in that is possible perform move!
-        if (ct->course->semester == 1)
-        {
-          profs_aux[p].professor->current_CH1 += ct->course->workload;      // adding to new professor
-          profs_aux[owner].professor->current_CH1 -= ct->course->workload;  // removing from old
-        }
-        else
-        {
-          profs_aux[p].professor->current_CH2 += ct->course->workload;
-          profs_aux[owner].professor->current_CH2 -= ct->course->workload;
-        }
-        ct->current_prof           = p;
-
-        // update assigned var mapping to point to the var of new professor
-        int new_prof_label         = profs_aux[p].professor->label;
-        assigned_var_for_course[j] = varlist[new_prof_label * m + j];
-        changed                    = 1;
-        repairs++;
-        break;  // try to satisfy next underloaded prof
-      }
+    // courses of the same semester that no longer fit in p lose p from their degree
+    for (e = graph->prof_start[p]; e < graph->prof_start[p + 1]; e++)
+    {
+      int u       = graph->prof_course[e];
+      Course *cu  = courses_aux[u].course;
+      int current = cu->semester == 1 ? profs_aux[p].current_CH1 : profs_aux[p].current_CH2;
+      int max     = cu->semester == 1 ? profs_aux[p].professor->maxWorkload1 : profs_aux[p].professor->maxWorkload2;
+
+      if (courses_aux[u].covered == 1 || cu->semester != course->semester) continue;
+      if (current - course->workload + cu->workload > max || current + cu->workload <= max) continue;
+
+      bucket_remove(&queue, u, courses_aux[u].level);
+      courses_aux[u].level--;
+      bucket_insert(&queue, u, courses_aux[u].level);
+      profs_aux[p].n--;
     }
-    if (!changed) break;
   }
 
-  int i = 0;
-  for (int p = 0; p < n; p++)
+  // courses without an eligible professor: give them to the first professor with capacity that the node allows
+  for (int i = 0; i < n_sem_prof; i++)
   {
-    if (profs_aux[p].professor->current_CH1 + profs_aux[p].professor->current_CH2 < profs_aux[p].professor->minWorkload) i++;
-  }
+    int course_label = courses_sem_profs[i].course->label;
+    Course *course   = courses_sem_profs[i].course;
 
-  // rebuild solution array from assigned_var_for_course
-  *nInSolution = 0;
-  for (int j = 0; j < m; j++)
-  {
-    if (assigned_var_for_course[j] != NULL)
+    for (int p = 0; p < n; p++)
     {
-      solution[(*nInSolution)++] = assigned_var_for_course[j];
+      if (forbidden[p * m + course_label] || !has_capacity(&profs_aux[p], course)) continue;
+
+      prof_label = profs_aux[p].professor->label;
+      if (course->semester == 1)
+        profs_aux[p].current_CH1 += course->workload;
+      else
+        profs_aux[p].current_CH2 += course->workload;
+      courses_aux[course_label].covered      = 1;
+      courses_aux[course_label].current_prof = prof_label;
+      (*nCovered)++;
+      break;
     }
   }
 
-  free(assigned_var_for_course);
-  free(course_by_label);
-  free(courses_sem_profs);
+  // repair phase: move courses along augmenting paths until every professor reaches minWorkload (when possible)
+  repair_min_workload(profs_aux, courses_aux, n, m, forbidden, locked, scratch);
 }
 
-SCIP_Real local_search(
-        SCIP *scip,               // SCIP instance
-        SCIP_VAR **varlist,       // array of all variables
-        SCIP_VAR **solution,      // array of all variables fixed in 1
-        int *nInSolution,         // number of variables in solution
-        ProfessorAux *profs_aux,  // auxiliar professor structures
-        Instance *I,              // instance with all courses data
-        int m,
-        int n)
+// start reactive GRASP with uniform probabilities and no statistics
+void reactive_reset(ReactiveT *reactive)
 {
-  int improved                   = 1;
-  int iterations                 = 0;
-  const int MAX_LOCAL_ITERATIONS = 10;  // limit local search iterations
-
-  // build mapping: course_label -> assigned professor
-  int *course_to_prof            = (int *) malloc(sizeof(int) * m);
-  for (int i = 0; i < m; i++)
+  for (int a = 0; a < GRASP_NALPHAS; a++)
   {
-    course_to_prof[i] = -1;
+    reactive->sum[a]   = 0.0;
+    reactive->count[a] = 0;
+    reactive->nfail[a] = 0;
+    reactive->prob[a]  = 1.0 / GRASP_NALPHAS;
   }
-  // fill mapping from current solution
-  for (int i = 0; i < *nInSolution; i++)
+  reactive->best  = -SCIP_DEFAULT_INFINITY;
+  reactive->worst = SCIP_DEFAULT_INFINITY;
+}
+
+// alpha value of index a
+float reactive_alpha(int a)
+{
+  return (float) (a + 1) / GRASP_NALPHAS;
+}
+
+// record the objective value of a feasible solution built with alpha index a
+void reactive_record(ReactiveT *reactive, int a, double value)
+{
+  reactive->sum[a] += value;
+  reactive->count[a]++;
+  if (value > reactive->best) reactive->best = value;
+  if (value < reactive->worst) reactive->worst = value;
+}
+
+// record an incomplete or infeasible solution built with alpha index a: it counts as the worst value seen
+void reactive_penalize(ReactiveT *reactive, int a)
+{
+  reactive->nfail[a]++;
+}
+
+// re-weight the alpha probabilities: q_a = (normalized average of alpha a)^delta (values never tried get q = 1); failed
+// constructions enter the average with the worst feasible value
+void reactive_update(ReactiveT *reactive)
+{
+  double q[GRASP_NALPHAS], total, range, average;
+  int a, nsols;
+
+  range = reactive->best - reactive->worst;
+  if (range < EPSILON)
+    return;
+
+  total = 0.0;
+  for (a = 0; a < GRASP_NALPHAS; a++)
   {
-    const char *varname = SCIPvarGetName(solution[i]);
-    int prof_id, course_id;
-    if (sscanf(varname, "x#%d#%d", &prof_id, &course_id) == 2)
+    nsols = reactive->count[a] + reactive->nfail[a];
+    if (nsols == 0)
+      q[a] = 1.0;
+    else
     {
-      course_to_prof[course_id] = prof_id;
+      average = (reactive->sum[a] + reactive->nfail[a] * reactive->worst) / nsols;
+      q[a]    = pow((average - reactive->worst) / range, GRASP_REACTIVE_DELTA);
     }
+    total += q[a];
   }
 
-  // verify that all courses are assigned (solution must be complete)
-  int num_assigned = 0;
-  for (int c = 0; c < m; c++)
+  // normalize, with a floor on each probability
+  for (a = 0; a < GRASP_NALPHAS; a++)
   {
-    if (course_to_prof[c] >= 0) num_assigned++;
+    reactive->prob[a] = total > EPSILON ? q[a] / total : 1.0 / GRASP_NALPHAS;
+    if (reactive->prob[a] < GRASP_REACTIVE_MINPROB) reactive->prob[a] = GRASP_REACTIVE_MINPROB;
   }
-
-  // nf solution is incomplete, abort local search
-  if (num_assigned < m)
+  total = 0.0;
+  for (a = 0; a < GRASP_NALPHAS; a++)
   {
-
-    free(course_to_prof);
-
-    // return current objective without changes
-    SCIP_Real obj_value = 0.0;
-    for (int i = 0; i < *nInSolution; i++)
-    {
-      obj_value += SCIPvarGetObj(solution[i]);
-    }
-    return obj_value;
+    total += reactive->prob[a];
   }
+  for (a = 0; a < GRASP_NALPHAS; a++)
+  {
+    reactive->prob[a] /= total;
+  }
+}
+
+// choose an alpha index with the probabilities of the distribution
+int reactive_choose(ReactiveT *reactive, RngT *rng)
+{
+  double r   = rngUniform(rng);
+  double acc = 0.0;
 
-  while (improved && iterations < MAX_LOCAL_ITERATIONS)
+  for (int a = 0; a < GRASP_NALPHAS - 1; a++)
   {
-    improved = 0;
-    iterations++;
+    acc += reactive->prob[a];
+    if (r < acc)
+      return a;
+  }
+  return GRASP_NALPHAS - 1;
+}
 
-    // try swap movements: reassign courser to different professors
-    for (int c1 = 0; c1 < m && !improved; c1++)
-    {
-      int prof1 = course_to_prof[c1];
-      if (prof1 < 0) continue;  // course not assigned
+// create an empty elite pool in the arena
+int elite_init(ElitePoolT *pool, GraspArena *arena, int capacity, int m, const ZobristT *zobrist)
+{
+  pool->assign   = (int *) arena_alloc(arena, sizeof(int) * capacity * m);
+  pool->value    = (double *) arena_alloc(arena, sizeof(double) * capacity);
+  pool->hash     = (uint64_t *) arena_alloc(arena, sizeof(uint64_t) * capacity);
+  pool->known    = (int *) arena_alloc(arena, sizeof(int) * capacity);
+  pool->size     = 0;
+  pool->capacity = capacity;
+  pool->m        = m;
+  pool->zobrist  = zobrist;
+  pool->mindiff  = (int) ceil(GRASP_ELITE_MINDIFF * m);
+  if (pool->mindiff < 1) pool->mindiff = 1;
+  return pool->assign != NULL && pool->value != NULL && pool->hash != NULL && pool->known != NULL;
+}
 
-      // access course directly from instance using label (c1 == label)
-      Course *course1 = &I->courses[c1];
+// bytes of an elite pool
+size_t elite_bytes(int capacity, int m)
+{
+  return ARENA_ROUND(sizeof(int) * capacity * m) + ARENA_ROUND(sizeof(double) * capacity) + ARENA_ROUND(sizeof(uint64_t) * capacity) +
+         ARENA_ROUND(sizeof(int) * capacity);
+}
 
-      // try to reassign course1 to a different professor
-      for (int prof2 = 0; prof2 < n && !improved; prof2++)
-      {
-        if (prof2 == prof1) continue;
+// index of the member of the pool with the given assignment (-1 if none); the hash is compared first
+int elite_find(const ElitePoolT *pool, const int *assign, uint64_t hash)
+{
+  for (int k = 0; k < pool->size; k++)
+  {
+    if (pool->hash[k] == hash && !memcmp(&pool->assign[k * pool->m], assign, sizeof(int) * pool->m))
+      return k;
+  }
+  return -1;
+}
 
-        // check if prof2 can take course1 (capacity constraints)
-        int can_assign = 0;
-        if (course1->semester == 1)
-        {
-          if (profs_aux[prof2].professor->current_CH1 + course1->workload <= profs_aux[prof2].professor->maxWorkload1 &&
-              profs_aux[prof1].professor->current_CH1 - course1->workload >= 0)
-          {
-            can_assign = 1;
-          }
-        }
-        else
-        {
-          if (profs_aux[prof2].professor->current_CH2 + course1->workload <= profs_aux[prof2].professor->maxWorkload2 &&
-              profs_aux[prof1].professor->current_CH2 - course1->workload >= 0)
-          {
-            can_assign = 1;
-          }
-        }
+// number of courses with different professors in two assignments
+int assignment_distance(const int *a, const int *b, int m)
+{
+  int d = 0;
+  for (int c = 0; c < m; c++)
+  {
+    if (a[c] != b[c]) d++;
+  }
+  return d;
+}
 
-        if (!can_assign) continue;
+// insert an assignment in the pool if it is good and different enough; return its index (-1 if not inserted)
+int elite_insert(ElitePoolT *pool, const int *assign, double value)
+{
+  uint64_t hash = zobristHash(pool->zobrist, assign);
+  int k, target, worst;
 
-        // check if this swap could improve objective (prefer higher preference weights)
-        double weight_prof1 = check_preference_weight(profs_aux[prof1].professor->preferences, m, c1);
-        double weight_prof2 = check_preference_weight(profs_aux[prof2].professor->preferences, m, c1);
+  if (elite_find(pool, assign, hash) >= 0)
+    return -1;
 
-        // only swap if prof2 has higher preference than prof1
-        if (weight_prof2 > weight_prof1 + EPSILON)
-        {
-          // check minWorkload constraint: ensure prof1 won't fall below minWorkload after removal
-          int prof1_total_after = profs_aux[prof1].professor->current_CH1 + profs_aux[prof1].professor->current_CH2 - course1->workload;
-          if (prof1_total_after < profs_aux[prof1].professor->minWorkload)
-          {
-            continue;  // skip this swap to avoid violating minWorkload
-          }
-
-          // perform swap
-          if (course1->semester == 1)
-          {
-            profs_aux[prof1].professor->current_CH1 -= course1->workload;
-            profs_aux[prof2].professor->current_CH1 += course1->workload;
-          }
-          else
-          {
-            profs_aux[prof1].professor->current_CH2 -= course1->workload;
-            profs_aux[prof2].professor->current_CH2 += course1->workload;
-          }
-
-          // update mapping
-          course_to_prof[c1] = prof2;
-          improved           = 1;
-        }
-      }
+  // a close member is replaced only by a better solution
+  target = -1;
+  for (k = 0; k < pool->size; k++)
+  {
+    if (assignment_distance(&pool->assign[k * pool->m], assign, pool->m) < pool->mindiff)
+    {
+      if (value <= pool->value[k] + EPSILON)
+        return -1;
+      target = k;
+      break;
     }
   }
 
-  // rebuild solution array from updated mapping
-  *nInSolution = 0;
-  for (int c = 0; c < m; c++)
+  if (target < 0 && pool->size < pool->capacity)
+    target = pool->size++;
+  else if (target < 0)
   {
-    int prof = course_to_prof[c];
-    if (prof >= 0)
+    // the pool is full: replace the worst member
+    worst = 0;
+    for (k = 1; k < pool->size; k++)
     {
-      solution[(*nInSolution)] = varlist[prof * m + c];
-      (*nInSolution)++;
+      if (pool->value[k] < pool->value[worst]) worst = k;
     }
+    if (value <= pool->value[worst] + EPSILON)
+      return -1;
+    target = worst;
   }
 
-  free(course_to_prof);
+  memcpy(&pool->assign[target * pool->m], assign, sizeof(int) * pool->m);
+  pool->value[target] = value;
+  pool->hash[target]  = hash;
+  pool->known[target] = 0;
+  return target;
+}
 
-  // calculate objective value of improved solution
-  SCIP_Real obj_value = 0.0;
-  for (int i = 0; i < *nInSolution; i++)
+/*
+ * path relinking: walk from the assignment source toward guide, one course at a time. Each step moves the course (among
+ * those still assigned differently) whose reassignment to its professor in guide keeps the semester workload limits and
+ * has the best objective delta (O(1) per course, from the aptitudes of the original maximized problem in shared->weight,
+ * so the largest delta is the best move); courses are never moved to a professor the node forbids. The best
+ * intermediate assignment that satisfies every minimal workload and uses no forbidden assignment (pool solutions of
+ * other nodes may use some) is stored in best; return its value, or -SCIP_DEFAULT_INFINITY if none beat bound.
+ * current, ch1, ch2 and diff are scratch arrays of size m, n, n and m.
+ */
+double path_relinking(GraspSharedT *shared, const int *source, const int *guide, double source_value, double bound,
+                      int *best, int *current, int *ch1, int *ch2, int *diff)
+{
+  Instance *I       = shared->I;
+  int n             = I->nProfessors;
+  int m             = I->nCourses;
+  double value      = source_value;
+  double best_value = -SCIP_DEFAULT_INFINITY;
+  int ndiff, nunder, nforbidden, c, p, q, step, chosen;
+  double delta, best_delta;
+
+  memcpy(current, source, sizeof(int) * m);
+  for (p = 0; p < n; p++)
   {
-    obj_value += SCIPvarGetObj(solution[i]);
+    ch1[p] = 0;
+    ch2[p] = 0;
+  }
+  ndiff      = 0;
+  nforbidden = 0;
+  for (c = 0; c < m; c++)
+  {
+    if (I->courses[c].semester == 1)
+      ch1[current[c]] += I->courses[c].workload;
+    else
+      ch2[current[c]] += I->courses[c].workload;
+    if (shared->forbidden[current[c] * m + c])
+      nforbidden++;
+    if (current[c] != guide[c])
+      diff[ndiff++] = c;
+  }
+  nunder = 0;
+  for (p = 0; p < n; p++)
+  {
+    if (ch1[p] + ch2[p] < I->professors[p].minWorkload) nunder++;
   }
 
-  return obj_value;
-}
-
-int grasp(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur)
-{
-  int found, infeasible, nInSolution, nInBestSolution;
-  unsigned int stored;
-  int nvars;
-  int *covered, n, m, nCovered;
-  SCIP_VAR *var, **solution, **best_solution, **varlist;
-  SCIP_Real valor, bestUb, best_obj_value;
-  SCIP_PROBDATA *probdata;
-  int i, k;
-  Instance *I;
-
-  // GRASP parameters (read from configuration file)
-  const int MAX_ITERATIONS   = param.grasp_max_iter;
-  const float ALPHA          = param.grasp_alpha;
-  const int USE_LOCAL_SEARCH = param.grasp_local_search;  // flag to enable/disable local search phase
-
-  // auxiliary structures for GRASP
-  ProfessorAux *profs_aux;
-  CourseAux *courses_aux;
-
-  found      = 0;
-  infeasible = 0;
-
-  /* recover the problem data */
-  probdata   = SCIPgetProbData(scip);
-  assert(probdata != NULL);
-
-  nvars       = SCIPprobdataGetNVars(probdata);
-  varlist     = SCIPprobdataGetVars(probdata);
-  I           = SCIPprobdataGetInstance(probdata);
-  n           = I->nProfessors;  // number of professors
-  m           = I->nCourses;     // number of courses
-
-  // allocate auxiliary structures (shared across iterations)
-  profs_aux   = (ProfessorAux *) malloc(sizeof(ProfessorAux) * n);
-  courses_aux = (CourseAux *) malloc(sizeof(CourseAux) * m);
-
-  // initialize auxiliary professor structures
-  for (i = 0; i < n; i++)
+  // the last step would reach guide itself, which is already known
+  while (ndiff > 1)
   {
-    profs_aux[i].professor = &I->professors[i];
-    profs_aux[i].n         = 0;
-    profs_aux[i].pref      = (PreferenceAux *) malloc(sizeof(PreferenceAux) * m);
+    chosen     = -1;
+    best_delta = -SCIP_DEFAULT_INFINITY;
+    for (step = 0; step < ndiff; step++)
+    {
+      Course *course = &I->courses[diff[step]];
+      c              = diff[step];
+      q              = guide[c];
+      if (shared->forbidden[q * m + c]) continue;
+      if (course->semester == 1 ? ch1[q] + course->workload > I->professors[q].maxWorkload1
+                                : ch2[q] + course->workload > I->professors[q].maxWorkload2)
+        continue;
+      delta = shared->weight[q * m + c] - shared->weight[current[c] * m + c];
+      if (delta > best_delta)
+      {
+        best_delta = delta;
+        chosen     = step;
+      }
+    }
+    if (chosen < 0)
+      break;  // no course can move without exceeding a workload limit or leaving the node
+
+    // apply the move and update the workloads and the number of professors below their minimal workload
+    c = diff[chosen];
+    p = current[c];
+    q = guide[c];
+    if (ch1[p] + ch2[p] < I->professors[p].minWorkload) nunder--;
+    if (ch1[q] + ch2[q] < I->professors[q].minWorkload) nunder--;
+    if (I->courses[c].semester == 1)
+    {
+      ch1[p] -= I->courses[c].workload;
+      ch1[q] += I->courses[c].workload;
+    }
+    else
+    {
+      ch2[p] -= I->courses[c].workload;
+      ch2[q] += I->courses[c].workload;
+    }
+    if (ch1[p] + ch2[p] < I->professors[p].minWorkload) nunder++;
+    if (ch1[q] + ch2[q] < I->professors[q].minWorkload) nunder++;
+    if (shared->forbidden[p * m + c]) nforbidden--;
+    current[c]   = q;
+    value       += best_delta;
+    diff[chosen] = diff[--ndiff];
+
+    if (nunder == 0 && nforbidden == 0 && value > bound + EPSILON && value > best_value + EPSILON)
+    {
+      best_value = value;
+      memcpy(best, current, sizeof(int) * m);
+    }
   }
+  return best_value;
+}
 
-  // initialize auxiliary course structures
-  for (i = 0; i < m; i++)
+// GRASP iterations of one worker: construction + local search with its own copies of the auxiliary structures
+void *grasp_worker(void *arg)
+{
+  GraspWorkerT *worker = (GraspWorkerT *) arg;
+  GraspSharedT *shared = worker->shared;
+  Instance *I          = shared->I;
+  int n                = I->nProfessors;
+  int m                = I->nCourses;
+  int i, k, nCovered, a, seed_member, feasible;
+  SCIP_Real valor;
+  uint64_t hash;
+  float alpha;
+
+  // the evaluator (and local search) keeps the bounds of the node: variables fixed to 0 are forbidden and fixed
+  // courses do not move
+  lsAllowAll(worker->ls);
+  for (i = 0; i < n * m; i++)
   {
-    courses_aux[i].course       = &I->courses[i];
-    courses_aux[i].covered      = 0;
-    courses_aux[i].current_prof = -1;
+    if (shared->forbidden[i]) lsForbid(worker->ls, i / m, i % m);
   }
+  for (i = 0; i < shared->nFixed; i++)
+    lsLock(worker->ls, shared->fixed_course[i]);
 
-  solution        = (SCIP_VAR **) malloc(sizeof(SCIP_VAR *) * (m * n));
-  best_solution   = (SCIP_VAR **) malloc(sizeof(SCIP_VAR *) * (m * n));
-  covered         = (int *) calloc(m, sizeof(int));
+  for (k = 0; k < worker->niterations; k++)
+  {
+    // a solution that reaches the dual bound of the node is optimal for its subtree
+    if (worker->found && worker->best_obj_value >= shared->node_bound - EPSILON)
+      break;
 
-  // initialize best solution as infinity
-  best_obj_value  = -SCIPinfinity(scip);
-  nInBestSolution = 0;
+    // release the scratch memory of the previous iteration
+    worker->scratch->used = 0;
 
-  // identify variables already fixed to 1.0 (these must be in every solution)
-  int nFixed      = 0;
-  for (i = 0; i < nvars; i++)
-  {
-    var = varlist[i];
-    if (SCIPvarGetLbLocal(var) > 1.0 - EPSILON)
-    {  // var >= 1.0
-      nFixed++;
-#ifdef DEBUG_GRASP
-      printf("\nFixed var= %s", SCIPvarGetName(var));
-#endif
+    // reactive GRASP: draw alpha from the learned distribution
+    a                     = -1;
+    alpha                 = shared->alpha;
+    if (shared->reactive)
+    {
+      a     = reactive_choose(&worker->reactive, &worker->rng);
+      alpha = reactive_alpha(a);
     }
-  }
 
-  // GRASP main loop - iterate maxitr times
-  for (k = 1; k <= MAX_ITERATIONS; k++)
-  {
 #ifdef DEBUG_GRASP
-    printf("\n--- GRASP Iteration %d/%d ---\n", k, MAX_ITERATIONS);
+    printf("\n--- GRASP worker %d: iteration %d/%d ---\n", worker->id, k + 1, worker->niterations);
 #endif
 
     // reset structures for new iteration
-    nInSolution = 0;
-    nCovered    = 0;
-    memset(covered, 0, m * sizeof(int));
+    nCovered = 0;
 
     // reset professor workloads for new iteration
     for (i = 0; i < n; i++)
     {
-      profs_aux[i].professor->current_CH1 = 0;
-      profs_aux[i].professor->current_CH2 = 0;
+      worker->profs_aux[i].current_CH1 = 0;
+      worker->profs_aux[i].current_CH2 = 0;
     }
 
     // reset courses_aux to original order and state
     for (i = 0; i < m; i++)
     {
-      courses_aux[i].course       = &I->courses[i];  // restore original order
-      courses_aux[i].covered      = 0;
-      courses_aux[i].current_prof = -1;
+      worker->courses_aux[i].course       = &I->courses[i];  // courses_aux is indexed by label
+      worker->courses_aux[i].covered      = 0;
+      worker->courses_aux[i].current_prof = -1;
     }
 
     //include fixed variables in current solution
-    int nFixedInIteration = 0;
-    for (i = 0; i < nvars; i++)
+    for (i = 0; i < shared->nFixed; i++)
     {
-      var = varlist[i];
-      if (SCIPvarGetLbLocal(var) > 1.0 - EPSILON)
-      {  // var >= 1.0
-        solution[nInSolution++] = var;
-        nFixedInIteration++;
-
-        // extract professor and course indices from variable name
-        const char *varname = SCIPvarGetName(var);
-        int prof_id, course_id;
-        if (sscanf(varname, "x#%d#%d", &prof_id, &course_id) == 2)
-        {
-          covered[course_id] = 1;
-          nCovered++;
-
-          // update course_aux to mark as covered
-          // find the course in courses_aux array (may be reordered, so search by label)
-          for (int c = 0; c < m; c++)
-          {
-            if (courses_aux[c].course->label == course_id)
-            {
-              courses_aux[c].covered      = 1;
-              courses_aux[c].current_prof = prof_id;
-              break;
-            }
-          }
-
-          // update professor workload
-          Course *fixed_course = &I->courses[course_id];
-          if (fixed_course->semester == 1)
-          {
-            profs_aux[prof_id].professor->current_CH1 += fixed_course->workload;
-          }
-          else
-          {
-            profs_aux[prof_id].professor->current_CH2 += fixed_course->workload;
-          }
-        }
+      int prof_id          = shared->fixed_prof[i];
+      int course_id        = shared->fixed_course[i];
+      Course *fixed_course = &I->courses[course_id];
+
+      worker->courses_aux[course_id].covered      = 1;
+      worker->courses_aux[course_id].current_prof = prof_id;
+      nCovered++;
+
+      // update professor workload
+      if (fixed_course->semester == 1)
+        worker->profs_aux[prof_id].current_CH1 += fixed_course->workload;
+      else
+        worker->profs_aux[prof_id].current_CH2 += fixed_course->workload;
+    }
+
+    // persistent pool: in the first half of the iterations, rebuild around a random part of a pool solution, keeping
+    // only the assignments allowed at the node
+    seed_member = worker->id + k * shared->nthreads;
+    if (shared->pool != NULL && k < worker->niterations / 2 && seed_member < shared->pool->size)
+    {
+      const int *seed_assign = &shared->pool->assign[seed_member * m];
+      for (i = 0; i < m; i++)
+      {
+        int p          = seed_assign[i];
+        Course *course = &I->courses[i];
+
+        if (worker->courses_aux[i].covered || shared->forbidden[p * m + i] || !has_capacity(&worker->profs_aux[p], course))
+          continue;
+        if (rngUniform(&worker->rng) >= GRASP_POOL_KEEP)
+          continue;
+        worker->courses_aux[i].covered      = 1;
+        worker->courses_aux[i].current_prof = p;
+        nCovered++;
+        if (course->semester == 1)
+          worker->profs_aux[p].current_CH1 += course->workload;
+        else
+          worker->profs_aux[p].current_CH2 += course->workload;
       }
     }
 
     // construction phase - build a randomized greedy solution
-    reset_course_level(courses_aux, m);
-    adaptive_edges(profs_aux, courses_aux, n, m);
-    qsort(courses_aux, m, sizeof(CourseAux), compareCourses);
+    construct_solution(shared->graph, shared->score, worker->profs_aux, worker->courses_aux, &nCovered, m, n, alpha, shared->lpval, shared->lp_prof, shared->lp_weight, shared->forbidden, shared->locked, &worker->rng, worker->scratch);
 
-    construct_solution(scip, varlist, solution, profs_aux, courses_aux, &nInSolution, &nCovered, m, n, ALPHA);
+    // a course without professor leaves every assignment constraint of SCIP unsatisfiable: not a candidate
+    for (i = 0; i < m && worker->courses_aux[i].current_prof >= 0; i++)
+    {
+      worker->assign[i] = worker->courses_aux[i].current_prof;
+    }
+    if (i < m)
+    {
+      if (a >= 0) reactive_penalize(&worker->reactive, a);
+      continue;
+    }
 
-    // local search phase (try) improve constructed solution
-    if (USE_LOCAL_SEARCH && nInSolution > 0)
+    // native evaluation: objective, workloads and Zobrist hash in O(n + m), then kept up to date by the local search
+    lsLoad(worker->ls, worker->assign);
+    if (shared->use_local_search)
     {
-      SCIP_Real local_obj = local_search(scip, varlist, solution, &nInSolution, profs_aux, I, m, n);
+      int nmoves = lsRun(worker->ls, shared->ls_strategy, shared->ls_neighborhoods, 0);
+#ifdef DEBUG_GRASP
+      printf("After local search: %d moves, obj=%.2f\n", nmoves, worker->ls->value);
+#else
+      (void) nmoves;
+#endif
+    }
+    valor    = worker->ls->value;
+    hash     = worker->ls->hash;
+    feasible = lsIsFeasible(worker->ls);
+
 #ifdef DEBUG_GRASP
-      printf("After local search: nInSolution=%d, obj=%.2f\n", nInSolution, local_obj);
+    printf("Current solution objective: %.4f (best so far: %.4f)\n", valor, worker->best_obj_value);
 #endif
+
+    // reactive GRASP: only feasible values reward alpha (an infeasible one may be high because it breaks a minimum)
+    if (a >= 0)
+    {
+      if (feasible)
+        reactive_record(&worker->reactive, a, valor);
+      else
+        reactive_penalize(&worker->reactive, a);
+      if ((k + 1) % GRASP_REACTIVE_PERIOD == 0)
+        reactive_update(&worker->reactive);
     }
 
-    // Calculate objective value of current solution
-    SCIP_SOL *current_sol;
-    SCIP_CALL(SCIPcreateSol(scip, &current_sol, heur));
+    // an assignment already sent to SCIP by a previous call brings nothing new to SCIP or to the pools
+    if (recentContains(shared->recent, hash))
+      continue;
+    // only solutions feasible at the node enter the elite (and, from it, path relinking and the persistent pool)
+    if (feasible && (shared->path_relinking || shared->pool != NULL))
+      elite_insert(&worker->elite, worker->ls->assign, valor);
 
-    for (i = 0; i < nInSolution; i++)
+    // update best solution of the worker if current is better and feasible at the node
+    if (feasible && valor > worker->best_obj_value + EPSILON)
     {
-      SCIP_CALL(SCIPsetSolVal(scip, current_sol, solution[i], 1.0));
+      worker->best_obj_value = valor;
+      worker->best_hash      = hash;
+      worker->found          = 1;
+      memcpy(worker->best_assign, worker->ls->assign, sizeof(int) * m);
     }
+  }
+  return NULL;
+}
+
+int grasp(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur)
+{
+  int found;
+  int *best_assign;
+  uint64_t best_hash;
+  unsigned int stored;
+  int nvars;
+  int n, m, nthreads, ncreated;
+  SCIP_VAR *var, **varlist;
+  SCIP_Real valor, bestUb;
+  SCIP_PROBDATA *probdata;
+  SCIP_HEURDATA *heurdata;
+  int i, w, ncut;
+  Instance *I;
+  GraspGraph nodegraph;
+
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  // GRASP parameters (read from configuration file)
+  const int MAX_ITERATIONS = heurdata->param.grasp_max_iter;
+
+  // auxiliary structures for GRASP
+  GraspArena *callarena;
+  GraspSharedT shared;
+  GraspWorkerT *workers;
+  pthread_t *threads;
+  RngT callrng;
 
-    valor = SCIPsolGetOrigObj(current_sol);
+  found    = 0;
 
+  /* recover the problem data */
+  probdata = SCIPgetProbData(scip);
+  assert(probdata != NULL);
+
+  nvars    = SCIPprobdataGetNVars(probdata);
+  varlist  = SCIPprobdataGetVars(probdata);
+  I        = SCIPprobdataGetInstance(probdata);
+  n        = I->nProfessors;  // number of professors
+  m        = I->nCourses;     // number of courses
+
+  // the graph and the memory are set up by heurInitGrasp; the memory of the previous call is released here
+  if (!heurdata->graph_built)
+    return 0;
+  callarena               = &heurdata->callarena;
+  callarena->used         = 0;
+
+  shared.scip             = scip;
+  shared.probdata         = probdata;
+  shared.varlist          = varlist;
+  shared.weight           = heurdata->ls[0]->weight;
+  shared.I                = I;
+  shared.score            = score_kernel_select();
+  shared.alpha            = heurdata->param.grasp_alpha;
+  shared.reactive         = heurdata->param.grasp_reactive;
+  shared.path_relinking   = heurdata->param.grasp_path_relinking;
+  shared.use_local_search = heurdata->param.grasp_local_search;  // flag to enable/disable local search phase
+  shared.ls_strategy      = (LS_Strategy) heurdata->param.ls_strategy;
+  shared.ls_neighborhoods = heurdata->param.ls_neighborhoods;
+  shared.fixed_prof       = (int *) arena_alloc(callarena, sizeof(int) * (m + 1));
+  shared.fixed_course     = (int *) arena_alloc(callarena, sizeof(int) * (m + 1));
+  shared.nFixed           = 0;
+
+  // variables fixed to 0 at the node: no construction, local search, seeded construction or path relinking uses them
+  shared.nthreads  = heurdata->nthreads;
+  shared.pool      = heurdata->param.grasp_elite_pool ? &heurdata->pool : NULL;
+  shared.zobrist   = heurdata->zobrist;
+  shared.recent    = heurdata->recent;
+  shared.forbidden = (char *) arena_alloc(callarena, sizeof(char) * n * m);
+  memset(shared.forbidden, 0, sizeof(char) * n * m);
+  shared.locked    = (char *) arena_alloc(callarena, sizeof(char) * m);
+  memset(shared.locked, 0, sizeof(char) * m);
+
+  // LP-guided construction: read the LP solution of the node (only when it is solved to optimality)
+  shared.lpval     = NULL;
+  shared.lp_prof   = NULL;
+  shared.lp_weight = heurdata->param.grasp_lp_weight;
+  if (heurdata->param.grasp_lp_guided && SCIPhasCurrentNodeLP(scip) && SCIPgetLPSolstat(scip) == SCIP_LPSOLSTAT_OPTIMAL)
+  {
+    shared.lpval   = (double *) arena_alloc(callarena, sizeof(double) * n * m);
+    shared.lp_prof = (int *) arena_alloc(callarena, sizeof(int) * m);
+    memset(shared.lpval, 0, sizeof(double) * n * m);
+    for (i = 0; i < m; i++)
+      shared.lp_prof[i] = -1;
+  }
+
+  // identify variables already fixed to 1.0 (these must be in every solution); read once, before the workers start
+  for (i = 0; i < nvars; i++)
+  {
+    int prof_id, course_id;
+    var = varlist[i];
+    if (!SCIPprobdataGetVarIndex(probdata, var, &prof_id, &course_id))
+      continue;
+    if (SCIPvarGetUbLocal(var) < 0.5)
+      shared.forbidden[prof_id * m + course_id] = 1;
+    if (shared.lpval != NULL)
+    {
+      valor                                 = SCIPvarGetLPSol(var);
+      shared.lpval[prof_id * m + course_id] = valor;
+      if (valor > 1.0 - EPSILON && !shared.forbidden[prof_id * m + course_id])
+        shared.lp_prof[course_id] = prof_id;
+    }
+    if (SCIPvarGetLbLocal(var) > 1.0 - EPSILON && shared.nFixed < m)
+    {  // var >= 1.0
+      shared.fixed_prof[shared.nFixed]   = prof_id;
+      shared.fixed_course[shared.nFixed] = course_id;
+      shared.locked[course_id]           = 1;
+      shared.nFixed++;
 #ifdef DEBUG_GRASP
-    printf("Current solution objective: %.4f (best so far: %.4f)\n", valor, best_obj_value);
+      printf("\nFixed var= %s", SCIPvarGetName(var));
 #endif
+    }
+  }
 
-    // Step 5: Update best solution if current is better
-    if (valor > best_obj_value + EPSILON)
+  // a course fixed to a professor can go to no other professor, even where propagation did not fix the variables to 0
+  for (i = 0; i < shared.nFixed; i++)
+  {
+    for (w = 0; w < n; w++)
     {
-      best_obj_value  = valor;
-      nInBestSolution = nInSolution;
+      if (w != shared.fixed_prof[i]) shared.forbidden[w * m + shared.fixed_course[i]] = 1;
+    }
+  }
+
+  // candidate index of the node: the graph of the instance without the edges fixed to 0 here
+  ncut = build_node_graph(&heurdata->graph, shared.forbidden, n, m, &nodegraph, callarena);
+  shared.graph      = ncut > 0 ? &nodegraph : &heurdata->graph;
+  shared.node_bound = SCIPgetLocalDualbound(scip);
+#ifdef DEBUG_GRASP
+  printf("\nGRASP at depth %d: %d edges fixed to 0, %d courses fixed, node bound %.4f\n", SCIPgetDepth(scip), ncut,
+         shared.nFixed, shared.node_bound);
+#endif
+
+  // split the iterations among the workers; the call takes a long jump of the stream of the heuristic, and each worker
+  // a jump of the stream of the call
+  callrng  = heurdata->rng;
+  rngLongJump(&heurdata->rng);
+  nthreads = heurdata->nthreads;
+  workers  = (GraspWorkerT *) arena_alloc(callarena, sizeof(GraspWorkerT) * nthreads);
+  threads  = (pthread_t *) arena_alloc(callarena, sizeof(pthread_t) * nthreads);
+  for (w = 0; w < nthreads; w++)
+  {
+    workers[w].id              = w;
+    workers[w].shared          = &shared;
+    workers[w].niterations     = MAX_ITERATIONS / nthreads + (w < MAX_ITERATIONS % nthreads ? 1 : 0);
+    workers[w].rng             = callrng;
+    rngJump(&callrng);
+    workers[w].scratch         = &heurdata->arenas[w];
+    workers[w].ls              = heurdata->ls[w];
+    workers[w].profs_aux       = (ProfessorAux *) arena_alloc(callarena, sizeof(ProfessorAux) * n);
+    workers[w].courses_aux     = (CourseAux *) arena_alloc(callarena, sizeof(CourseAux) * m);
+    workers[w].best_assign     = (int *) arena_alloc(callarena, sizeof(int) * m);
+    workers[w].best_obj_value  = -SCIPinfinity(scip);
+    workers[w].found           = 0;
+    workers[w].best_hash       = 0;
+    workers[w].reactive        = heurdata->reactive;
+    workers[w].assign          = (int *) arena_alloc(callarena, sizeof(int) * m);
+    elite_init(&workers[w].elite, callarena, GRASP_ELITE_SIZE, m, heurdata->zobrist);
+
+    // initialize auxiliary professor structures
+    for (i = 0; i < n; i++)
+    {
+      workers[w].profs_aux[i].professor = &I->professors[i];
+      workers[w].profs_aux[i].n         = 0;
+    }
+  }
+
+  // worker 0 runs in this thread; if a thread cannot be created, its iterations are run here too
+  ncreated = 0;
+  for (w = 1; w < nthreads; w++)
+  {
+    if (pthread_create(&threads[w], NULL, grasp_worker, &workers[w]) != 0)
+      break;
+    ncreated++;
+  }
+  grasp_worker(&workers[0]);
+  for (w = 1; w <= ncreated; w++)
+  {
+    pthread_join(threads[w], NULL);
+  }
+  for (w = ncreated + 1; w < nthreads; w++)
+  {
+    grasp_worker(&workers[w]);
+  }
 
-      // Copy current solution to best solution
-      for (i = 0; i < nInSolution; i++)
+  // reactive GRASP: add the statistics of every worker to the distribution of the heuristic (used by the next calls)
+  if (shared.reactive)
+  {
+    ReactiveT base = heurdata->reactive;
+    for (w = 0; w < nthreads; w++)
+    {
+      for (int a = 0; a < GRASP_NALPHAS; a++)
       {
-        best_solution[i] = solution[i];
+        heurdata->reactive.sum[a] += workers[w].reactive.sum[a] - base.sum[a];
+        heurdata->reactive.count[a] += workers[w].reactive.count[a] - base.count[a];
+        heurdata->reactive.nfail[a] += workers[w].reactive.nfail[a] - base.nfail[a];
       }
-
+      if (workers[w].reactive.best > heurdata->reactive.best) heurdata->reactive.best = workers[w].reactive.best;
+      if (workers[w].reactive.worst < heurdata->reactive.worst) heurdata->reactive.worst = workers[w].reactive.worst;
+    }
+    reactive_update(&heurdata->reactive);
 #ifdef DEBUG_GRASP
-      printf("*** New best solution found! Objective: %.4f ***\n", best_obj_value);
+    printf("\nReactive GRASP alpha probabilities:");
+    for (int a = 0; a < GRASP_NALPHAS; a++)
+      printf(" %.1f:%.3f(%d)", reactive_alpha(a), heurdata->reactive.prob[a], heurdata->reactive.count[a]);
+    printf("\n");
 #endif
-    }
+  }
 
-    // Free current iteration solution
-    SCIP_CALL(SCIPfreeSol(scip, &current_sol));
+  // reduction: every worker kept its own best solution, so no locking is needed; ties go to the lowest worker
+  best_assign = NULL;
+  valor       = 0.0;
+  best_hash   = 0;
+  for (w = 0; w < nthreads; w++)
+  {
+    if (workers[w].found && (best_assign == NULL || workers[w].best_obj_value > valor + EPSILON))
+    {
+      best_assign = workers[w].best_assign;
+      valor       = workers[w].best_obj_value;
+      best_hash   = workers[w].best_hash;
+    }
   }
 
-  // ================= END OF GRASP ===============================================
+  // elite solutions of the call: the members of the persistent pool (known if relinked by an earlier call) and those of
+  // the workers
+  ElitePoolT elite;
+  int s, g;
+  elite.size = 0;
+  if (shared.path_relinking || shared.pool != NULL)
+  {
+    elite_init(&elite, callarena, GRASP_ELITE_SIZE + GRASP_POOL_SIZE, m, heurdata->zobrist);
+    if (shared.pool != NULL && shared.path_relinking)
+    {
+      for (s = 0; s < shared.pool->size; s++)
+      {
+        g = elite_insert(&elite, &shared.pool->assign[s * m], shared.pool->value[s]);
+        if (g >= 0) elite.known[g] = shared.pool->known[s];
+      }
+    }
+    for (w = 0; w < nthreads; w++)
+    {
+      for (s = 0; s < workers[w].elite.size; s++)
+        elite_insert(&elite, &workers[w].elite.assign[s * m], workers[w].elite.value[s]);
+    }
+  }
 
-  // After all iterations, store the best solution found
-  if (nInBestSolution > 0)
+  // path relinking between every ordered pair of elite solutions of the call (pairs relinked by previous calls are skipped)
+  if (shared.path_relinking && elite.size > 1)
   {
-    /* create SCIP solution structure sol */
-    SCIP_CALL(SCIPcreateSol(scip, sol, heur));
+    int *pr_best           = (int *) arena_alloc(callarena, sizeof(int) * m);
+    int *pr_current        = (int *) arena_alloc(callarena, sizeof(int) * m);
+    int *pr_diff           = (int *) arena_alloc(callarena, sizeof(int) * m);
+    int *pr_ch1            = (int *) arena_alloc(callarena, sizeof(int) * n);
+    int *pr_ch2            = (int *) arena_alloc(callarena, sizeof(int) * n);
+    int *pr_solution       = (int *) arena_alloc(callarena, sizeof(int) * m);
+    double pr_value, pr_best_value = best_assign != NULL ? valor : -SCIP_DEFAULT_INFINITY;
+    uint64_t pr_hash = 0, hash;
+    int improved     = 0;
+
+    for (s = 0; s < elite.size; s++)
+    {
+      for (g = 0; g < elite.size; g++)
+      {
+        if (s == g || (elite.known[s] && elite.known[g])) continue;
+        pr_value = path_relinking(&shared, &elite.assign[s * m], &elite.assign[g * m], elite.value[s], pr_best_value,
+                                  pr_best, pr_current, pr_ch1, pr_ch2, pr_diff);
+        if (pr_value <= pr_best_value + EPSILON)
+          continue;
+        // assignments already sent to SCIP are skipped
+        hash = zobristHash(shared.zobrist, pr_best);
+        if (!recentContains(shared.recent, hash))
+        {
+          // the best assignment is kept in pr_solution (pr_best is overwritten by the next paths)
+          pr_best_value = pr_value;
+          pr_hash       = hash;
+          memcpy(pr_solution, pr_best, sizeof(int) * m);
+          improved = 1;
+        }
+      }
+    }
+#ifdef DEBUG_GRASP
+    printf("\nPath relinking: %d elite solutions, best %.4f (construction %.4f)\n", elite.size, pr_best_value, valor);
+#endif
+    if (improved)
+    {
+      best_assign = pr_solution;
+      valor       = pr_best_value;
+      best_hash   = pr_hash;
+    }
+  }
 
-    // save best solution in sol
-    for (i = 0; i < nInBestSolution; i++)
+  // persistent pool: keep the new elite solutions and the best one of the call for the next calls. Only solutions
+  // feasible at the node are kept (path relinking does not look at the bounds of the node); a member is known once it
+  // was relinked, which says nothing about being sent to SCIP (the recent set records that)
+  if (shared.pool != NULL)
+  {
+    for (s = 0; s < elite.size; s++)
     {
-      var = best_solution[i];
-      SCIP_CALL(SCIPsetSolVal(scip, *sol, var, 1.0));
+      if (!elite.known[s])
+      {
+        lsLoad(heurdata->ls[0], &elite.assign[s * m]);
+        if (!lsIsFeasible(heurdata->ls[0])) continue;
+        g = elite_insert(shared.pool, &elite.assign[s * m], elite.value[s]);
+        if (g >= 0) shared.pool->known[g] = shared.path_relinking;
+      }
     }
+    if (best_assign != NULL)
+    {
+      lsLoad(heurdata->ls[0], best_assign);
+      if (lsIsFeasible(heurdata->ls[0]))
+      {
+        g = elite_insert(shared.pool, best_assign, valor);
+        if (g >= 0) shared.pool->known[g] = shared.path_relinking;
+      }
+    }
+  }
 
-    // compute objective value of the best solution
-    bestUb = SCIPgetPrimalbound(scip);
-    valor  = SCIPsolGetOrigObj(*sol);
+  // ================= END OF GRASP ===============================================
 
+  // exact verdict of the native evaluator at the node (path relinking does not look at the bounds of the node); only a
+  // feasible solution that beats the incumbent is sent to SCIP
+  if (best_assign != NULL)
+  {
+    lsLoad(heurdata->ls[0], best_assign);
+    assert(fabs(heurdata->ls[0]->value - valor) < EPSILON);  // incremental values of the workers and path relinking
+    if (!lsIsFeasible(heurdata->ls[0]))
+      best_assign = NULL;
+  }
+  bestUb = SCIPgetPrimalbound(scip);
+  if (best_assign != NULL && valor <= bestUb + EPSILON)
+  {
 #ifdef DEBUG_GRASP
-    printf("\n=== GRASP finished ===\n");
-    printf("Best solution value: %.4f, Current upper bound: %.4f\n", valor, bestUb);
+    printf("\nGRASP solution %.4f does not beat the primal bound %.4f: not sent to SCIP\n", valor, bestUb);
 #endif
+    best_assign = NULL;
+  }
+
+  // store the best solution found; it is remembered, so later calls do not send it again (the workers and the path
+  // relinking already skipped the assignments sent by earlier calls)
+  if (best_assign != NULL)
+  {
+    recentInsert(heurdata->recent, best_hash);
+
+    /* create SCIP solution structure sol */
+    SCIP_CALL(SCIPcreateSol(scip, sol, heur));
+    SCIP_CALL(SCIPprobdataSetAssignment(scip, probdata, *sol, best_assign));
+    /* GRASP scores with the aptitudes of the original (maximized) problem; the transformed coefficients are negated */
+    assert(SCIPisFeasEQ(scip, SCIPgetSolOrigObj(scip, *sol), valor));
 
 #ifdef DEBUG_GRASP
+    printf("\n=== GRASP finished ===\n");
+    printf("Best solution value: %.4f, Current primal bound: %.4f\n", valor, bestUb);
     printf("Trying to store solution...\n");
     SCIP_CALL(SCIPprintSol(scip, *sol, NULL, FALSE));
 #endif
 
-    /* check if the solution is feasible */
-    SCIP_CALL(SCIPtrySol(scip, *sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored));
+    /* every row (assignment, semester maxima, minimal workloads) and bound was checked by the native evaluator */
+    SCIP_CALL(SCIPtrySol(scip, *sol, FALSE, FALSE, FALSE, FALSE, FALSE, &stored));
     if (stored)
     {
 #ifdef DEBUG_GRASP
-      printf("\nSolution is feasible and was stored! Total assignments = %d\n", nInBestSolution);
+      printf("\nSolution is feasible and was stored!\n");
 #endif
       found = 1;
     }
@@ -959,23 +1767,206 @@ int grasp(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur)
     }
   }
 
-  // Free auxiliary structures
+  // auxiliary structures live in the arenas of the heuristic: nothing to free
+  return found;
+}
+
+/**
+ * heuristic mode: GRASP iterations on the instance, without a SCIP model, until timelimit seconds of wall-clock time
+ * passed. With --heur_lns 1, every other iteration rebuilds the best assignment after removing a random lns_perc of its
+ * courses. Returns 1 if a complete assignment with every professor at its minimal workload was found (best_assign,
+ * best_value), 0 if not, -1 if there is no memory.
+ */
+int grasp_standalone(Instance *I, const parametersT *param, double timelimit, int *best_assign, double *best_value, long long *niterations)
+{
+  int n = I->nProfessors;
+  int m = I->nCourses;
+  GraspGraph graph;
+  GraspArena scratch;
+  ProfessorAux *profs_aux;
+  CourseAux *courses_aux;
+  char *forbidden, *locked;
+  int *assign;
+  LocalSearchT *ls;
+  ScoreKernelT score = score_kernel_select();
+  ReactiveT reactive;
+  RngT rng;
+  struct timespec start, now;
+  int i, a, nCovered, feasible, found = 0;
+  float alpha;
+  long long k;
+
+  *niterations = 0;
+  if (!build_grasp_graph(I, &graph))
+    return -1;
+  scratch.size = grasp_iteration_bytes(n, m);
+  scratch.used = 0;
+  scratch.base = (char *) malloc(scratch.size);
+  profs_aux    = (ProfessorAux *) malloc(sizeof(ProfessorAux) * n);
+  courses_aux  = (CourseAux *) malloc(sizeof(CourseAux) * m);
+  forbidden    = (char *) calloc(n * m, sizeof(char));
+  locked       = (char *) calloc(m, sizeof(char));
+  assign       = (int *) malloc(sizeof(int) * m);
+  ls           = lsCreate(I);
+  if (scratch.base == NULL || !profs_aux || !courses_aux || !forbidden || !locked || !assign || !ls)
+  {
+    found = -1;
+    goto TERMINATE;
+  }
+  reactive_reset(&reactive);
+  rngSeed(&rng, (uint64_t) param->seed, RNG_STREAM_GRASP);
   for (i = 0; i < n; i++)
   {
-    free(profs_aux[i].pref);
+    profs_aux[i].professor = &I->professors[i];
+    profs_aux[i].n         = 0;
   }
-  free(profs_aux);
-  free(courses_aux);
-  free(solution);
-  free(best_solution);
-  free(covered);
 
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (k = 0;; k++)
+  {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if ((now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) * 1e-9 >= timelimit || getInterruptSignal())
+      break;
+
+    scratch.used = 0;
+    a            = -1;
+    alpha        = (float) param->grasp_alpha;
+    if (param->grasp_reactive)
+    {
+      a     = reactive_choose(&reactive, &rng);
+      alpha = reactive_alpha(a);
+    }
+
+    nCovered = 0;
+    for (i = 0; i < n; i++)
+    {
+      profs_aux[i].current_CH1 = 0;
+      profs_aux[i].current_CH2 = 0;
+    }
+    for (i = 0; i < m; i++)
+    {
+      courses_aux[i].course       = &I->courses[i];
+      courses_aux[i].covered      = 0;
+      courses_aux[i].current_prof = -1;
+    }
+
+    // LNS operator: destroy a random lns_perc of the courses of the best assignment and rebuild them
+    if (param->heur_lns && found && k % 2 == 1)
+    {
+      for (i = 0; i < m; i++)
+      {
+        int p          = best_assign[i];
+        Course *course = &I->courses[i];
+
+        if (rngUniform(&rng) < param->lns_perc || !has_capacity(&profs_aux[p], course))
+          continue;
+        courses_aux[i].covered      = 1;
+        courses_aux[i].current_prof = p;
+        nCovered++;
+        if (course->semester == 1)
+          profs_aux[p].current_CH1 += course->workload;
+        else
+          profs_aux[p].current_CH2 += course->workload;
+      }
+    }
+
+    construct_solution(&graph, score, profs_aux, courses_aux, &nCovered, m, n, alpha, NULL, NULL, 0.0, forbidden, locked, &rng, &scratch);
+
+    // only complete assignments are evaluated
+    for (i = 0; i < m && courses_aux[i].current_prof >= 0; i++)
+    {
+      assign[i] = courses_aux[i].current_prof;
+    }
+    feasible = 0;
+    if (i == m)
+    {
+      lsLoad(ls, assign);
+      if (param->grasp_local_search)
+        lsRun(ls, (LS_Strategy) param->ls_strategy, param->ls_neighborhoods, 0);
+      feasible = lsIsFeasible(ls);
+    }
+
+    // incomplete and infeasible assignments count as the worst value for their alpha
+    if (a >= 0)
+    {
+      if (feasible)
+        reactive_record(&reactive, a, ls->value);
+      else
+        reactive_penalize(&reactive, a);
+      if ((k + 1) % GRASP_REACTIVE_PERIOD == 0)
+        reactive_update(&reactive);
+    }
+    if (feasible && (!found || ls->value > *best_value + EPSILON))
+    {
+      memcpy(best_assign, ls->assign, sizeof(int) * m);
+      *best_value = ls->value;
+      found       = 1;
+    }
+  }
+  *niterations = k;
+
+TERMINATE:
+  lsFree(&ls);
+  free(assign);
+  free(locked);
+  free(forbidden);
+  free(courses_aux);
+  free(profs_aux);
+  free(scratch.base);
+  free_grasp_graph(&graph);
   return found;
 }
+/**
+ * adaptive scheduling: returns TRUE if GRASP should run in this call. After an execution that did not improve the
+ * incumbent, once GRASP used more than GRASP_SCHED_SHARE of the solving time, the next backoff calls are skipped and the
+ * backoff doubles. A new incumbent (found by any heuristic) or a large dual bound move since the last execution resets it.
+ */
+static SCIP_Bool schedule_grasp(SCIP *scip, SCIP_HEURDATA *heurdata)
+{
+  SCIP_Real upper = SCIPgetUpperbound(scip);
+  SCIP_Real lower = SCIPgetLowerbound(scip);
+  SCIP_Bool moved = FALSE;
+
+  if (!SCIPisInfinity(scip, upper) && !SCIPisInfinity(scip, -heurdata->sched_lower))
+    moved = lower - heurdata->sched_lower > GRASP_SCHED_BOUNDMOVE * MAX(upper - heurdata->sched_lower, 1.0);
+  if (heurdata->backoff > 1 && (SCIPisLT(scip, upper, heurdata->sched_upper) || moved))
+  {
+    heurdata->backoff = 1;
+    heurdata->skip    = 0;
+    heurdata->nresets++;
+  }
+  if (heurdata->skip > 0)
+  {
+    heurdata->skip--;
+    heurdata->nskipped++;
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/** adaptive scheduling: records an execution of time seconds and sets the calls to skip */
+static void schedule_update(SCIP *scip, SCIP_HEURDATA *heurdata, SCIP_Real upper_before, SCIP_Real time)
+{
+  SCIP_Real upper = SCIPgetUpperbound(scip);
+
+  heurdata->exectime    += time;
+  heurdata->sched_upper  = upper;
+  heurdata->sched_lower  = SCIPgetLowerbound(scip);
+  if (SCIPisLT(scip, upper, upper_before))
+    heurdata->backoff = 1;
+  else if (heurdata->exectime > GRASP_SCHED_SHARE * SCIPgetSolvingTime(scip))
+  {
+    heurdata->skip    = heurdata->backoff;
+    heurdata->backoff = MIN(2 * heurdata->backoff, GRASP_SCHED_MAXBACKOFF);
+  }
+}
+
 /** execution method of primal heuristic */
 static SCIP_DECL_HEUREXEC(heurExecGrasp)
 {                /*lint --e{715}*/
+  SCIP_HEURDATA *heurdata;
   SCIP_SOL *sol; /**< solution to round */
+  SCIP_Real upper_before, start;
   int nlpcands;
 
   assert(result != NULL);
@@ -999,6 +1990,13 @@ static SCIP_DECL_HEUREXEC(heurExecGrasp)
   if (nlpcands == 0)
     return SCIP_OKAY;
 
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+  if (heurdata->param.grasp_adaptive && !schedule_grasp(scip, heurdata))
+    return SCIP_OKAY;
+  upper_before = SCIPgetUpperbound(scip);
+  start        = SCIPgetSolvingTime(scip);
+
   /* solve grasp */
   if (grasp(scip, &sol, heur))
   {
@@ -1011,6 +2009,7 @@ static SCIP_DECL_HEUREXEC(heurExecGrasp)
     printf("\nGrasp could not find feasible solution!");
 #endif
   }
+  schedule_update(scip, heurdata, upper_before, SCIPgetSolvingTime(scip) - start);
   return SCIP_OKAY;
 }
 
@@ -1018,16 +2017,105 @@ static SCIP_DECL_HEUREXEC(heurExecGrasp)
  * primal heuristic specific interface methods
  */
 
+/** returns the number of calls skipped by the adaptive scheduling */
+SCIP_Longint SCIPheurGraspGetNSkipped(
+        SCIP_HEUR *heur /**< GRASP heuristic */
+)
+{
+  SCIP_HEURDATA *heurdata;
+
+  assert(heur != NULL);
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  return heurdata->nskipped;
+}
+
+/** returns the number of times the adaptive scheduling re-enabled GRASP after a new incumbent or a dual bound move */
+SCIP_Longint SCIPheurGraspGetNResets(
+        SCIP_HEUR *heur /**< GRASP heuristic */
+)
+{
+  SCIP_HEURDATA *heurdata;
+
+  assert(heur != NULL);
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  return heurdata->nresets;
+}
+
+/**
+ * copies the members of the persistent elite pool into assign (member k at assign[k * nCourses]) and value; returns
+ * their number (at most GRASP_POOL_SIZE)
+ */
+int SCIPheurGraspGetPool(
+        SCIP_HEUR *heur, /**< GRASP heuristic */
+        int *assign,     /**< output: assignments of the members (GRASP_POOL_SIZE x nCourses) */
+        double *value    /**< output: objective value of each member (GRASP_POOL_SIZE) */
+)
+{
+  SCIP_HEURDATA *heurdata;
+  ElitePoolT *pool;
+
+  assert(heur != NULL);
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  pool = &heurdata->pool;
+  if (pool->size > 0)
+  {
+    memcpy(assign, pool->assign, sizeof(int) * pool->size * pool->m);
+    memcpy(value, pool->value, sizeof(double) * pool->size);
+  }
+  return pool->size;
+}
+
+/** sets the members loaded into the persistent elite pool when the solve starts (resume from a checkpoint) */
+SCIP_RETCODE SCIPheurGraspSetPool(
+        SCIP *scip,          /**< SCIP data structure */
+        SCIP_HEUR *heur,     /**< GRASP heuristic */
+        const int *assign,   /**< assignments of the members (member k at assign[k * nCourses]) */
+        const double *value, /**< objective value of each member */
+        int size,            /**< number of members (at most GRASP_POOL_SIZE) */
+        int nCourses         /**< number of courses */
+)
+{
+  SCIP_HEURDATA *heurdata;
+
+  assert(heur != NULL);
+  assert(size >= 0 && size <= GRASP_POOL_SIZE);
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  SCIPfreeMemoryArrayNull(scip, &heurdata->resume_assign);
+  SCIPfreeMemoryArrayNull(scip, &heurdata->resume_value);
+  heurdata->nresume = 0;
+  if (size == 0)
+    return SCIP_OKAY;
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->resume_assign, size * nCourses));
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->resume_value, size));
+  memcpy(heurdata->resume_assign, assign, sizeof(int) * size * nCourses);
+  memcpy(heurdata->resume_value, value, sizeof(double) * size);
+  heurdata->nresume = size;
+  return SCIP_OKAY;
+}
+
 /** creates the grasp_crtp primal heuristic and includes it in SCIP */
 SCIP_RETCODE SCIPincludeHeurGrasp(
-        SCIP *scip /**< SCIP data structure */
+        SCIP *scip,              /**< SCIP data structure */
+        const parametersT *param /**< parameters of the solve (copied into the heuristic data) */
 )
 {
   SCIP_HEURDATA *heurdata;
   SCIP_HEUR *heur;
 
   /* create grasp primal heuristic data */
-  heurdata = NULL;
+  SCIP_CALL(SCIPallocMemory(scip, &heurdata));
+  heurdata->param         = *param;
+  heurdata->resume_assign = NULL;
+  heurdata->resume_value  = NULL;
+  heurdata->nresume       = 0;
 
   heur     = NULL;
 
@@ -1045,8 +2133,8 @@ SCIP_RETCODE SCIPincludeHeurGrasp(
     * compile independent of new callbacks being added in future SCIP versions
     */
   SCIP_CALL(SCIPincludeHeurBasic(scip, &heur,
-                                 HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, param.heur_round_freq, param.heur_round_freqofs,
-                                 param.heur_round_maxdepth, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecGrasp, heurdata));
+                                 HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, param->heur_round_freq, param->heur_round_freqofs,
+                                 param->heur_round_maxdepth, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecGrasp, heurdata));
 
   assert(heur != NULL);
 
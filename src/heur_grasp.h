@@ -26,9 +26,12 @@
 #ifndef __SCIP_HEUR_GRASP_H__
 #define __SCIP_HEUR_GRASP_H__
 
+#include "parameters_dpd.h"
 #include "probdata_dpd.h"
 #include "scip/scip.h"
 
+#define GRASP_POOL_SIZE 20 /**< maximal number of solutions of the persistent pool (--grasp_elite_pool 1) */
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -46,20 +49,95 @@ typedef struct
   Course *course;    // pointer to the original course
   int covered;       // 0 or 1 - if course is covered
   int current_prof;  // assigned professor label
+  int level;         // number of professors that can still teach the course (degree of the vertex)
 } CourseAux;
 
 typedef struct
 {
   Professor *professor;  // pointer to the original professor
-  int n;                 // degree of vertex (number of courses professor can teach)
-  PreferenceAux *pref;   // preferences list for GRASP (dynamically allocated)
+  int n;                 // degree of vertex (number of uncovered courses the professor can still teach)
+  int current_CH1;       // workload assigned in the first semester
+  int current_CH2;       // workload assigned in the second semester
 } ProfessorAux;
 
+// bipartite graph professor-course of the instance (adjacency lists in CSR form, built once per GRASP call)
+typedef struct
+{
+  int *prof_start;      // courses of professor p are prof_course[prof_start[p] .. prof_start[p+1]-1]
+  int *prof_course;     // course labels
+  int *course_start;    // professors of course t are course_prof[course_start[t] .. course_start[t+1]-1]
+  int *course_prof;     // professor labels
+  double *course_base;  // base score of each edge of course_prof (preference weight, or 1 for area-based edges)
+} GraspGraph;
+
+// scratch memory with a bump allocator: allocations are released all at once by resetting used
+typedef struct
+{
+  char *base;   // buffer (allocated once per solve)
+  size_t size;  // size of the buffer in bytes
+  size_t used;  // bytes in use
+} GraspArena;
+
+// bucket priority queue of courses by level (doubly linked list per level)
+typedef struct
+{
+  int *head;     // first course of each level (-1 = empty)
+  int *next;     // next course in the list of its level
+  int *prev;     // previous course in the list of its level
+  int min;       // lower bound on the smallest non-empty level
+  int maxlevel;  // largest level
+} BucketQueue;
+
   int grasp(SCIP *scip, SCIP_SOL **sol, SCIP_HEUR *heur);
 
+  /**
+   * heuristic mode: runs GRASP iterations (construction, local search and, with --heur_lns 1, destroy-and-rebuild of
+   * the best assignment) on the instance for timelimit seconds, without a SCIP model. Returns 1 if best_assign (the
+   * professor of each course) and best_value were set, 0 if no feasible assignment was found, -1 if there is no memory.
+   */
+  int grasp_standalone(
+          Instance *I,              /**< instance */
+          const parametersT *param, /**< parameters (GRASP, local search, LNS and seed) */
+          double timelimit,         /**< wall-clock budget in seconds */
+          int *best_assign,         /**< output: professor of each course */
+          double *best_value,       /**< output: objective value of best_assign */
+          long long *niterations    /**< output: number of iterations */
+  );
+
+  /** returns the number of calls skipped by the adaptive scheduling */
+  SCIP_Longint SCIPheurGraspGetNSkipped(
+          SCIP_HEUR *heur /**< GRASP heuristic */
+  );
+
+  /** returns the number of times the adaptive scheduling re-enabled GRASP after a new incumbent or a dual bound move */
+  SCIP_Longint SCIPheurGraspGetNResets(
+          SCIP_HEUR *heur /**< GRASP heuristic */
+  );
+
+  /**
+   * copies the members of the persistent elite pool into assign (member k at assign[k * nCourses]) and value; returns
+   * their number (at most GRASP_POOL_SIZE)
+   */
+  int SCIPheurGraspGetPool(
+          SCIP_HEUR *heur, /**< GRASP heuristic */
+          int *assign,     /**< output: assignments of the members (GRASP_POOL_SIZE x nCourses) */
+          double *value    /**< output: objective value of each member (GRASP_POOL_SIZE) */
+  );
+
+  /** sets the members loaded into the persistent elite pool when the solve starts (resume from a checkpoint) */
+  SCIP_RETCODE SCIPheurGraspSetPool(
+          SCIP *scip,          /**< SCIP data structure */
+          SCIP_HEUR *heur,     /**< GRASP heuristic */
+          const int *assign,   /**< assignments of the members (member k at assign[k * nCourses]) */
+          const double *value, /**< objective value of each member */
+          int size,            /**< number of members (at most GRASP_POOL_SIZE) */
+          int nCourses         /**< number of courses */
+  );
+
   /** creates the grasp_crtp primal heuristic and includes it in SCIP */
   SCIP_RETCODE SCIPincludeHeurGrasp(
-          SCIP *scip /**< SCIP data structure */
+          SCIP *scip,               /**< SCIP data structure */
+          const parametersT *param  /**< parameters of the solve (copied into the heuristic data) */
   );
 
 #ifdef __cplusplus
@@ -20,16 +20,17 @@
 
 /*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
 
+#include "dpd.h"
 #include "heur_lns.h"
+#include "localsearch_dpd.h"
 #include "parameters_dpd.h"
 #include "probdata_dpd.h"
 #include "scip/scip.h"
 #include "utils.h"
+#include "zobrist_dpd.h"
 #include <assert.h>
 #include <string.h>
 
-extern char output_path[512];
-
 #define DEBUG_LNS 0
 #if DEBUG_LNS
 #define PRINTFLNS(...) printf("\nLNS: " __VA_ARGS__)
@@ -47,6 +48,7 @@ extern char output_path[512];
 #define HEUR_MAXDEPTH -1                      /**< maximal level to be called. -1 = no limit */
 #define HEUR_TIMING SCIP_HEURTIMING_AFTERNODE /**< when the heuristic should be called? SCIP_HEURTIMING_DURINGLPLOOP or SCIP_HEURTIMING_AFTERNODE */
 #define HEUR_USESSUBSCIP TRUE                 /**< does the heuristic use a secondary SCIP instance? */
+#define LNS_RECENT_LOG2 10                    /**< the set of assignments already sent to SCIP has 2^10 slots */
 
 #ifdef DEBUG
 #define PRINTF(...) printf(__VA_ARGS__)
@@ -71,8 +73,12 @@ struct SCIP_HeurData
   SCIP_Bool initialized;     /**< whether the data structures are initialized */
   SCIP_Real lastSolValue;    /**< objective value of the last processed solution */
   SCIP_Longint nExecutions;  /**< number of effective LNS executions */
+  parametersT param;         /**< parameters of the solve (neighborhood size and order, sub-SCIP limits) */
+  LocalSearchT *ls;          /**< local search that polishes the sub-SCIP solutions (--lns_local_search 1) */
+  int *assignment;           /**< professor of each course in the solution of the sub-SCIP */
+  ZobristT *zobrist;         /**< keys of the hashes of the assignments */
+  RecentSetT *recent;        /**< assignments already sent to the main SCIP */
 };
-SCIP_RETCODE configScip(SCIP **pscip, parametersT param);
 
 /*
  * Local methods
@@ -116,6 +122,13 @@ static SCIP_DECL_HEURFREE(heurFreeLns)
   if (heurdata->candidates != NULL)
     SCIPfreeMemoryArray(scip, &heurdata->candidates);
 
+  if (heurdata->assignment != NULL)
+    SCIPfreeMemoryArray(scip, &heurdata->assignment);
+
+  lsFree(&heurdata->ls);
+  zobristFree(&heurdata->zobrist);
+  recentFree(&heurdata->recent);
+
   /* free heuristic data */
   SCIPfreeMemory(scip, &heurdata);
   SCIPheurSetData(heur, NULL);
@@ -152,19 +165,33 @@ static SCIP_DECL_HEURINIT(heurInitLns)
   SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->fixed, heurdata->arraySize));
   SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->fixedCourse, instance->nCourses));
   SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->candidates, instance->nCourses));
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->assignment, instance->nCourses));
+
+  /* duplicate detection: the same neighborhood often gives back the same assignment */
+  heurdata->zobrist = zobristCreate(instance->nProfessors, instance->nCourses, (uint64_t) heurdata->param.seed);
+  heurdata->recent  = recentCreate(LNS_RECENT_LOG2);
+  if (heurdata->zobrist == NULL || heurdata->recent == NULL)
+    return SCIP_NOMEMORY;
+
+  if (heurdata->param.lns_local_search)
+  {
+    heurdata->ls = lsCreate(instance);
+    if (heurdata->ls == NULL)
+      return SCIP_NOMEMORY;
+    lsSetZobrist(heurdata->ls, heurdata->zobrist);
+  }
 
   /* Create sub-SCIP instance for reuse */
-  parametersT lnsparam;
-  lnsparam.time_limit    = param.lns_time;
-  lnsparam.display_freq  = param.display_freq;
-  lnsparam.area_penalty  = param.area_penalty;
+  parametersT lnsparam   = heurdata->param;
+  lnsparam.time_limit    = heurdata->param.lns_time;
   lnsparam.nodes_limit   = -1;
   lnsparam.heur_rounding = 0;
   lnsparam.heur_bad_sol  = 0;
   lnsparam.heur_lns      = 0;
   lnsparam.heur_grasp    = 0;
+  strcpy(lnsparam.profile, "legacy");  // the sub-MIP keeps its own fixed settings
 
-  SCIP_RETCODE retcode   = configScip(&heurdata->subscip, lnsparam);
+  SCIP_RETCODE retcode   = configScip(&heurdata->subscip, &lnsparam);
   /* Apply basic SCIP parameters for sub-problem */
 
   SCIP_CALL(SCIPsetIntParam(heurdata->subscip, "presolving/maxrounds", 0));
@@ -363,7 +390,7 @@ int lns(SCIP *scip, SCIP_SOL *initsol, SCIP_HEUR *heur)
   }
 
   // order candidate professors by avgPreferenceWeight according to lns_order parameter
-  if (strcmp(param.lns_order, "crescente") == 0)
+  if (strcmp(heurdata->param.lns_order, "crescente") == 0)
   {
     PRINTFLNS("Ordering candidates in ASCENDING order (crescente)");
     qsort(cand, nCands, sizeof(LNS_Candidate), compareCandidatesAscending);
@@ -386,7 +413,7 @@ int lns(SCIP *scip, SCIP_SOL *initsol, SCIP_HEUR *heur)
   }
 
   // Obs: nCandsProfessors is smaller than I->nProfessors
-  toRemove = nCands * (param.lns_perc);
+  toRemove = nCands * (heurdata->param.lns_perc);
   PRINTFLNS("Number of candidate assignments: %d", nCands);
   PRINTFLNS("Number of Courses to remove: %d", toRemove);
 
@@ -417,7 +444,7 @@ int lns(SCIP *scip, SCIP_SOL *initsol, SCIP_HEUR *heur)
 #if DEBUG_LNS
   // Write LP only in debug to avoid heavy I/O in production
   char lns_lp_path[600];
-  snprintf(lns_lp_path, sizeof(lns_lp_path), "%s/lns.lp", output_path);
+  snprintf(lns_lp_path, sizeof(lns_lp_path), "%s/lns.lp", heurdata->param.output_path);
   PRINTFLNS("Writing LNS problem to %s", lns_lp_path);
   SCIP_CALL(SCIPwriteOrigProblem(heurdata->subscip, lns_lp_path, "lp", TRUE));
 #endif
@@ -447,15 +474,69 @@ int lns(SCIP *scip, SCIP_SOL *initsol, SCIP_HEUR *heur)
   PRINTFLNS("\nLNS solution found with objective value: %lf", lnsZ);
   PRINTFLNS("Initial solution objective value: %lf\n", z);
 
-  // --- ADD: Transfer LNS solution to main SCIP only if better ---
+  // polish the solution of the sub-SCIP with the local search, keeping the global bounds of the main SCIP
+  SCIP_Bool polished = FALSE;
+  if (lnsSol != NULL && heurdata->ls != NULL && SCIPprobdataGetAssignment(heurdata->subscip, probdata2, lnsSol, heurdata->assignment))
+  {
+    LocalSearchT *ls = heurdata->ls;
+    double before;
+
+    lsAllowAll(ls);
+    for (idx = 0; idx < I->nProfessors * I->nCourses; idx++)
+    {
+      if (SCIPvarGetUbGlobal(vars[idx]) < EPSILON)
+        lsForbid(ls, idx / I->nCourses, idx % I->nCourses);
+      else if (SCIPvarGetLbGlobal(vars[idx]) > 1.0 - EPSILON)
+        lsLock(ls, idx % I->nCourses);
+    }
+    lsLoad(ls, heurdata->assignment);
+    before = ls->value;
+    if (lsRun(ls, (LS_Strategy) heurdata->param.ls_strategy, heurdata->param.ls_neighborhoods, 0) > 0 && ls->value > before + EPSILON)
+    {
+      memcpy(heurdata->assignment, ls->assign, I->nCourses * sizeof(int));
+      lnsZ    += ls->value - before;
+      polished = TRUE;
+      PRINTFLNS("Local search improved the LNS solution to %lf", lnsZ);
+    }
+  }
+
+  // hash of the assignment to transfer (kept up to date by the local search when it was polished)
+  uint64_t hash    = 0;
+  SCIP_Bool hashed = FALSE;
   if (lnsSol != NULL && lnsZ >= z + EPSILON)
   {
+    if (polished)
+    {
+      hash   = heurdata->ls->hash;
+      hashed = TRUE;
+    }
+    else if (SCIPprobdataGetAssignment(heurdata->subscip, probdata2, lnsSol, heurdata->assignment))
+    {
+      hash   = zobristHash(heurdata->zobrist, heurdata->assignment);
+      hashed = TRUE;
+    }
+  }
+
+  // --- ADD: Transfer LNS solution to main SCIP only if better (and not sent before) ---
+  if (hashed && recentContains(heurdata->recent, hash))
+  {
+    PRINTFLNS("LNS solution %lf was already sent to main SCIP, not transferring it again.", lnsZ);
+  }
+  else if (lnsSol != NULL && lnsZ >= z + EPSILON)
+  {
+    if (hashed)
+      recentInsert(heurdata->recent, hash);
     SCIP_CALL(SCIPcreateSol(scip, &sol, heur));
-    for (int idx = 0; idx < I->nProfessors * I->nCourses; idx++)
+    if (polished)
+      SCIP_CALL(SCIPprobdataSetAssignment(scip, probdata, sol, heurdata->assignment));
+    else
     {
-      SCIP_Real val = SCIPgetSolVal(heurdata->subscip, lnsSol, vars2[idx]);
-      if (val > EPSILON)
-        SCIP_CALL(SCIPsetSolVal(scip, sol, vars[idx], val));
+      for (int idx = 0; idx < I->nProfessors * I->nCourses; idx++)
+      {
+        SCIP_Real val = SCIPgetSolVal(heurdata->subscip, lnsSol, vars2[idx]);
+        if (val > EPSILON)
+          SCIP_CALL(SCIPsetSolVal(scip, sol, vars[idx], val));
+      }
     }
 
     // check if the solution found by LNS is better than the current bestsolution
@@ -574,9 +655,39 @@ SCIP_Longint SCIPheurLnsGetNExecutions(
   return heurdata->nExecutions;
 }
 
+/** returns the objective value of the last solution processed by LNS */
+SCIP_Real SCIPheurLnsGetLastSolValue(
+        SCIP_HEUR *heur /**< LNS heuristic */
+)
+{
+  SCIP_HEURDATA *heurdata;
+
+  assert(heur != NULL);
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  return heurdata->lastSolValue;
+}
+
+/** sets the objective value of the last solution processed by LNS (used when resuming from a checkpoint) */
+void SCIPheurLnsSetLastSolValue(
+        SCIP_HEUR *heur, /**< LNS heuristic */
+        SCIP_Real value  /**< objective value */
+)
+{
+  SCIP_HEURDATA *heurdata;
+
+  assert(heur != NULL);
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  heurdata->lastSolValue = value;
+}
+
 /** creates the lns_crtp primal heuristic and includes it in SCIP */
 SCIP_RETCODE SCIPincludeHeurLns(
-        SCIP *scip /**< SCIP data structure */
+        SCIP *scip,              /**< SCIP data structure */
+        const parametersT *param /**< parameters of the solve (copied into the heuristic data) */
 )
 {
   SCIP_HEURDATA *heurdata;
@@ -588,10 +699,15 @@ SCIP_RETCODE SCIPincludeHeurLns(
   heurdata->fixed        = NULL;
   heurdata->fixedCourse  = NULL;
   heurdata->candidates   = NULL;
+  heurdata->assignment   = NULL;
+  heurdata->ls           = NULL;
+  heurdata->zobrist      = NULL;
+  heurdata->recent       = NULL;
   heurdata->arraySize    = 0;
   heurdata->initialized  = FALSE;
   heurdata->lastSolValue = -SCIPinfinity(scip); /* Initialize with -infinity */
   heurdata->nExecutions  = 0;
+  heurdata->param        = *param;
 
   heur                   = NULL;
 
@@ -26,6 +26,7 @@
 #ifndef __SCIP_HEUR_LNS_H__
 #define __SCIP_HEUR_LNS_H__
 
+#include "parameters_dpd.h"
 #include "problem.h"
 #include "scip/scip.h"
 
@@ -47,9 +48,21 @@ extern "C"
           SCIP_HEUR *heur /**< LNS heuristic */
   );
 
+  /** returns the objective value of the last solution processed by LNS */
+  SCIP_Real SCIPheurLnsGetLastSolValue(
+          SCIP_HEUR *heur /**< LNS heuristic */
+  );
+
+  /** sets the objective value of the last solution processed by LNS (used when resuming from a checkpoint) */
+  void SCIPheurLnsSetLastSolValue(
+          SCIP_HEUR *heur, /**< LNS heuristic */
+          SCIP_Real value  /**< objective value */
+  );
+
   /** creates the lns_crtp primal heuristic and includes it in SCIP */
   SCIP_RETCODE SCIPincludeHeurLns(
-          SCIP *scip /**< SCIP data structure */
+          SCIP *scip,               /**< SCIP data structure */
+          const parametersT *param  /**< parameters of the solve (copied into the heuristic data) */
   );
 
 #ifdef __cplusplus
@@ -0,0 +1,285 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_portfolio.c
+ * @brief  portfolio primal heuristic (incumbent exchange between parallel workers)
+ * @author Edna Hoshino (based on template provided by Tobias Achterberg)
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "heur_portfolio.h"
+#include "parameters_dpd.h"
+#include "probdata_dpd.h"
+#include "problem.h"
+
+/* configuracao da heuristica */
+#define HEUR_NAME "portfolio"
+#define HEUR_DESC "injects incumbents found by the other portfolio workers"
+#define HEUR_DISPCHAR 'P'
+#define HEUR_PRIORITY 1000                    /**< heuristics of high priorities are called first */
+#define HEUR_FREQ 1                           /**< heuristic call frequency. 1 = in all levels of the B&B tree */
+#define HEUR_FREQOFS 0                        /**< starts of level 0 (root node) */
+#define HEUR_MAXDEPTH -1                      /**< maximal level to be called. -1 = no limit */
+#define HEUR_TIMING SCIP_HEURTIMING_AFTERNODE /**< when the heuristic should be called? SCIP_HEURTIMING_DURINGLPLOOP or SCIP_HEURTIMING_AFTERNODE */
+#define HEUR_USESSUBSCIP FALSE                /**< does the heuristic use a secondary SCIP instance? */
+
+/*
+ * Data structures
+ */
+
+/** primal heuristic data */
+struct SCIP_HeurData
+{
+  SharedIncumbent *shared; /**< incumbent shared by the workers */
+  int worker;              /**< id of the worker owning this SCIP */
+  int lastversion;         /**< version of the shared incumbent already processed */
+  int *assignment;         /**< local copy of the shared assignment */
+  SCIP_Longint nInjected;  /**< number of shared incumbents stored by this SCIP */
+};
+
+/*
+ * Local methods
+ */
+
+/** is objective value a better than b (original space)? */
+static SCIP_Bool isBetter(SCIP *scip, SCIP_Real a, SCIP_Real b)
+{
+  if (SCIPgetObjsense(scip) == SCIP_OBJSENSE_MAXIMIZE)
+    return SCIPisGT(scip, a, b);
+  return SCIPisLT(scip, a, b);
+}
+
+/*
+ * Callback methods of primal heuristic
+ */
+
+/** destructor of primal heuristic to free user data (called when SCIP is exiting) */
+static SCIP_DECL_HEURFREE(heurFreePortfolio)
+{ /*lint --e{715}*/
+  SCIP_HEURDATA *heurdata;
+
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  if (heurdata->assignment != NULL)
+    SCIPfreeMemoryArray(scip, &heurdata->assignment);
+  SCIPfreeMemory(scip, &heurdata);
+  SCIPheurSetData(heur, NULL);
+
+  return SCIP_OKAY;
+}
+
+/** execution method of primal heuristic */
+static SCIP_DECL_HEUREXEC(heurExecPortfolio)
+{ /*lint --e{715}*/
+  SCIP_HEURDATA *heurdata;
+  SharedIncumbent *shared;
+  SCIP_SOL *bestsol, *sol;
+  SCIP_Real sharedobj;
+  SCIP_Bool inject, stored;
+
+  assert(result != NULL);
+  *result  = SCIP_DIDNOTRUN;
+
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+  shared = heurdata->shared;
+
+  /* another worker already proved optimality: stop this one */
+  pthread_mutex_lock(&shared->lock);
+  if (shared->finished)
+  {
+    pthread_mutex_unlock(&shared->lock);
+    SCIP_CALL(SCIPinterruptSolve(scip));
+    return SCIP_OKAY;
+  }
+  pthread_mutex_unlock(&shared->lock);
+
+  /* publish the local incumbent */
+  bestsol = SCIPgetBestSol(scip);
+  if (bestsol != NULL && SCIPsolGetHeur(bestsol) != heur)
+    (void) sharedIncumbentPublish(scip, shared, bestsol, heurdata->worker);
+
+  /* copy a newer shared incumbent found by another worker */
+  inject    = FALSE;
+  sharedobj = 0.0;
+  pthread_mutex_lock(&shared->lock);
+  if (shared->hassol && shared->version != heurdata->lastversion && shared->owner != heurdata->worker)
+  {
+    memcpy(heurdata->assignment, shared->assignment, shared->nCourses * sizeof(int));
+    sharedobj = shared->bestobj;
+    inject    = TRUE;
+  }
+  heurdata->lastversion = shared->version;
+  pthread_mutex_unlock(&shared->lock);
+
+  if (!inject || (bestsol != NULL && !isBetter(scip, sharedobj, SCIPgetSolOrigObj(scip, bestsol))))
+    return SCIP_OKAY;
+
+  SCIP_CALL(SCIPcreateSol(scip, &sol, heur));
+  SCIP_CALL(SCIPprobdataSetAssignment(scip, SCIPgetProbData(scip), sol, heurdata->assignment));
+  SCIP_CALL(SCIPtrySolFree(scip, &sol, FALSE, FALSE, TRUE, TRUE, TRUE, &stored));
+  if (stored)
+  {
+    heurdata->nInjected++;
+    *result = SCIP_FOUNDSOL;
+  }
+  else
+    *result = SCIP_DIDNOTFIND;
+
+  return SCIP_OKAY;
+}
+
+/*
+ * primal heuristic specific interface methods
+ */
+
+/** allocates an empty shared incumbent */
+SharedIncumbent *sharedIncumbentCreate(int nCourses)
+{
+  SharedIncumbent *shared;
+
+  shared = (SharedIncumbent *) malloc(sizeof(SharedIncumbent));
+  if (shared == NULL)
+    return NULL;
+  shared->assignment = (int *) malloc(nCourses * sizeof(int));
+  if (shared->assignment == NULL)
+  {
+    free(shared);
+    return NULL;
+  }
+  pthread_mutex_init(&shared->lock, NULL);
+  shared->nCourses = nCourses;
+  shared->hassol   = FALSE;
+  shared->bestobj  = 0.0;
+  shared->owner    = -1;
+  shared->version  = 0;
+  shared->finished = 0;
+  return shared;
+}
+
+/** frees a shared incumbent */
+void sharedIncumbentFree(SharedIncumbent **pshared)
+{
+  if (*pshared == NULL)
+    return;
+  pthread_mutex_destroy(&(*pshared)->lock);
+  free((*pshared)->assignment);
+  free(*pshared);
+  *pshared = NULL;
+}
+
+/** publishes sol as shared incumbent if it is better than the current one; returns TRUE if it was published */
+SCIP_Bool sharedIncumbentPublish(
+        SCIP *scip,              /**< SCIP data structure of the worker */
+        SharedIncumbent *shared, /**< shared incumbent */
+        SCIP_SOL *sol,           /**< solution of the worker */
+        int worker               /**< worker id */
+)
+{
+  SCIP_Real obj;
+  SCIP_Bool published;
+  int *assignment;
+
+  assert(shared != NULL);
+  if (sol == NULL)
+    return FALSE;
+
+  obj = SCIPgetSolOrigObj(scip, sol);
+
+  /* cheap check before extracting the assignment */
+  pthread_mutex_lock(&shared->lock);
+  published = !shared->hassol || isBetter(scip, obj, shared->bestobj);
+  pthread_mutex_unlock(&shared->lock);
+  if (!published)
+    return FALSE;
+
+  assignment = (int *) malloc(shared->nCourses * sizeof(int));
+  if (assignment == NULL)
+    return FALSE;
+  published = SCIPprobdataGetAssignment(scip, SCIPgetProbData(scip), sol, assignment);
+
+  if (published)
+  {
+    pthread_mutex_lock(&shared->lock);
+    /* another worker may have published in between */
+    published = !shared->hassol || isBetter(scip, obj, shared->bestobj);
+    if (published)
+    {
+      memcpy(shared->assignment, assignment, shared->nCourses * sizeof(int));
+      shared->hassol  = TRUE;
+      shared->bestobj = obj;
+      shared->owner   = worker;
+      shared->version++;
+    }
+    pthread_mutex_unlock(&shared->lock);
+  }
+  free(assignment);
+  return published;
+}
+
+/** returns the number of shared incumbents injected in the SCIP of the worker */
+SCIP_Longint SCIPheurPortfolioGetNInjected(
+        SCIP_HEUR *heur /**< portfolio heuristic */
+)
+{
+  SCIP_HEURDATA *heurdata;
+
+  assert(heur != NULL);
+  heurdata = SCIPheurGetData(heur);
+  assert(heurdata != NULL);
+
+  return heurdata->nInjected;
+}
+
+/** creates the portfolio primal heuristic and includes it in SCIP */
+SCIP_RETCODE SCIPincludeHeurPortfolio(
+        SCIP *scip,              /**< SCIP data structure */
+        SharedIncumbent *shared, /**< incumbent shared by the workers */
+        int worker               /**< id of the worker owning scip */
+)
+{
+  SCIP_HEURDATA *heurdata;
+  SCIP_HEUR *heur;
+
+  assert(shared != NULL);
+
+  /* create portfolio primal heuristic data */
+  SCIP_CALL(SCIPallocMemory(scip, &heurdata));
+  heurdata->shared      = shared;
+  heurdata->worker      = worker;
+  heurdata->lastversion = 0;
+  heurdata->nInjected   = 0;
+  SCIP_CALL(SCIPallocMemoryArray(scip, &heurdata->assignment, shared->nCourses));
+
+  heur = NULL;
+
+  /* include primal heuristic */
+  SCIP_CALL(SCIPincludeHeurBasic(scip, &heur,
+                                 HEUR_NAME, HEUR_DESC, HEUR_DISPCHAR, HEUR_PRIORITY, HEUR_FREQ, HEUR_FREQOFS,
+                                 HEUR_MAXDEPTH, HEUR_TIMING, HEUR_USESSUBSCIP, heurExecPortfolio, heurdata));
+
+  assert(heur != NULL);
+
+  /* set non fundamental callbacks via setter functions */
+  SCIP_CALL(SCIPsetHeurFree(scip, heur, heurFreePortfolio));
+
+  return SCIP_OKAY;
+}
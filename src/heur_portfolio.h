@@ -0,0 +1,82 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                           */
+/*                  This file is part of the program and library             */
+/*         SCIP --- Solving Constraint Integer Programs                      */
+/*                                                                           */
+/*    Copyright (C) 2002-2016 Konrad-Zuse-Zentrum                            */
+/*                            fuer Informationstechnik Berlin                */
+/*                                                                           */
+/*  SCIP is distributed under the terms of the ZIB Academic License.         */
+/*                                                                           */
+/*  You should have received a copy of the ZIB Academic License              */
+/*  along with SCIP; see the file COPYING. If not email to scip@zib.de.      */
+/*                                                                           */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/**@file   heur_portfolio.h
+ * @ingroup PRIMALHEURISTICS
+ * @brief  portfolio primal heuristic: exchanges incumbents between SCIP instances solved in parallel threads
+ *
+ * Each portfolio worker includes this heuristic. After each node it publishes the best solution of its SCIP into
+ * the shared incumbent (if it is better), injects the shared incumbent found by another worker (if it is better
+ * than the local one) and interrupts the solve once some worker proved optimality.
+ */
+
+/*---+----1----+----2----+----3----+----4----+----5----+----6----+----7----+----8----+----9----+----0----+----1----+----2*/
+
+#ifndef __SCIP_HEUR_PORTFOLIO_H__
+#define __SCIP_HEUR_PORTFOLIO_H__
+
+#include <pthread.h>
+
+#include "scip/scip.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /** incumbent shared by all portfolio workers, stored as the professor assigned to each course */
+  typedef struct
+  {
+    pthread_mutex_t lock; /**< protects all fields below */
+    int nCourses;         /**< number of courses of the instance */
+    int *assignment;      /**< professor assigned to each course in the shared incumbent */
+    SCIP_Bool hassol;     /**< is there a shared incumbent? */
+    SCIP_Real bestobj;    /**< objective value (original space) of the shared incumbent */
+    int owner;            /**< worker that published the shared incumbent */
+    int version;          /**< incremented at each new shared incumbent */
+    int finished;         /**< set when a worker finished its solve proving optimality (or infeasibility) */
+  } SharedIncumbent;
+
+  /** allocates an empty shared incumbent */
+  SharedIncumbent *sharedIncumbentCreate(int nCourses);
+
+  /** frees a shared incumbent */
+  void sharedIncumbentFree(SharedIncumbent **pshared);
+
+  /** publishes sol as shared incumbent if it is better than the current one; returns TRUE if it was published */
+  SCIP_Bool sharedIncumbentPublish(
+          SCIP *scip,              /**< SCIP data structure of the worker */
+          SharedIncumbent *shared, /**< shared incumbent */
+          SCIP_SOL *sol,           /**< solution of the worker */
+          int worker               /**< worker id */
+  );
+
+  /** returns the number of shared incumbents injected in the SCIP of the worker */
+  SCIP_Longint SCIPheurPortfolioGetNInjected(
+          SCIP_HEUR *heur /**< portfolio heuristic */
+  );
+
+  /** creates the portfolio primal heuristic and includes it in SCIP */
+  SCIP_RETCODE SCIPincludeHeurPortfolio(
+          SCIP *scip,              /**< SCIP data structure */
+          SharedIncumbent *shared, /**< incumbent shared by the workers */
+          int worker               /**< id of the worker owning scip */
+  );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
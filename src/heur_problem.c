@@ -9,14 +9,9 @@
 #include "parameters_dpd.h"
 #include "probdata_dpd.h"
 
-int randomIntegerB(int low, int high)
+int randomIntegerB(RngT *rng, int low, int high)
 {
-  int k;
-  double d;
-
-  d = (double) rand() / ((double) RAND_MAX + 1);
-  k = d * (high - low + 1);
-  return low + k;
+  return rngInt(rng, low, high);
 }
 /**
  * @brief split lambda variables in three groups according to its LP value:
@@ -126,26 +121,21 @@ void printLPvars(SCIP *scip, SCIP_VAR **pvars, int n1, int nfrac, int n0)
 /**
  * @brief Update the cost and the vector of itens covered
  *
+ * @param scip problem
  * @param var the variable that is used to update the current solution (given by covered and cost)
- * @param n the size of itens, which refers to the part of consids's var that has information concerning itens
  * @param covered the vector of itens already covered (and that must be updated) 
  * @param nCovered the number of itens in covered
  * @param cost the current cost of the solution, that must be updated
- * @return always return 1 (not used yet). 
+ * @return 1 if var belongs to the model, 0 otherwise. 
  */
-int updateSolution(SCIP_VAR *var, Instance *I, int *covered, int *nCovered, int *cost)
+int updateSolution(SCIP *scip, SCIP_VAR *var, int *covered, int *nCovered, int *cost)
 {
-  int a, i;
-  // update item covered by the current solution
-  const char *name;
+  int professor, course;
 
-  name = SCIPvarGetName(var);
-  a    = 0;
-  for (i = 4; name[i] != '\0'; i++)
-  {
-    a = a * 10 + name[i] - 48;
-  }
-  covered[a] = 1;
+  // update course covered by the current solution
+  if (!SCIPprobdataGetVarIndex(SCIPgetProbData(scip), var, &professor, &course))
+    return 0;
+  covered[course] = 1;
   (*nCovered)++;
   //*cost += I->items[a].weight; //comented, update if needed
   return 1;
@@ -203,27 +193,20 @@ SCIP_Real createSolution(SCIP *scip, SCIP_SOL *sol, SCIP_VAR **solution, int nSo
 int isFeasibleColumn(SCIP *scip, SCIP_VAR **solution, int nInSolution, int *covered, SCIP_VAR *var)
 {
   SCIP_PROBDATA *probdata;
-  int i, feasible, weight;
+  int feasible;
   Instance *I;
-  int a;
-  // update item covered by the current solution
-  const char *name;
-
-  name = SCIPvarGetName(var);
-  a    = 0;
-  for (i = 4; name[i] != '\0'; i++)
-  {
-    a = a * 10 + name[i] - 48;
-  }
+  int professor, course;
 
+  /* recover problem's data */
   probdata = SCIPgetProbData(scip);
   assert(probdata != NULL);
-  I        = SCIPprobdataGetInstance(probdata);
+  I = SCIPprobdataGetInstance(probdata);
+
+  // course (and professor) of the candidate column
+  if (!SCIPprobdataGetVarIndex(probdata, var, &professor, &course))
+    return 0;
 
   feasible = 1;
-  /* recover problem's data */
-  probdata = SCIPgetProbData(scip);
-  assert(probdata != NULL);
   // TODO: we are considering that there is one constraint for each compact variable in PMR
   // TODO: should consider specific requirements for the problem
   // weight = 0;
@@ -232,7 +215,7 @@ int isFeasibleColumn(SCIP *scip, SCIP_VAR **solution, int nInSolution, int *cove
   //       weight+=I->items[i].weight;
   //    }
   // }
-  // if(weight + I->items[a].weight > I->C[0]){ // Here, we just do not allow non-disjoint columns and non-relaxed columns
+  // if(weight + I->items[course].weight > I->C[0]){ // Here, we just do not allow non-disjoint columns and non-relaxed columns
   //   feasible = 0;
   // }
   //comented
@@ -3,6 +3,7 @@
 
 
 #include "problem.h"
+#include "rng_dpd.h"
 #include "scip/scip.h"
 
 #ifdef __cplusplus
@@ -16,10 +17,10 @@ extern "C"
     SCIP_Real solval;
   } candidatoT;
 
-  int randomIntegerB(int low, int high);
+  int randomIntegerB(RngT *rng, int low, int high);
   int getLPsolution(SCIP *scip, SCIP_VAR **pvars, int *pn1, int *pnfrac, int *pn0, int *pnlpcands);
   void printLPvars(SCIP *scip, SCIP_VAR **pvars, int n1, int nfrac, int n0);
-  int updateSolution(SCIP_VAR *var, Instance *I, int *covered, int *nCovered, int *cost);
+  int updateSolution(SCIP *scip, SCIP_VAR *var, int *covered, int *nCovered, int *cost);
   SCIP_Real createSolution(SCIP *scip, SCIP_SOL *sol, SCIP_VAR **solution, int nSolution, int *infeasible, int *covered);
   int isFeasibleColumn(SCIP *scip, SCIP_VAR **solution, int nInSolution, int *covered, SCIP_VAR *var);
   SCIP_RETCODE selectCand(SCIP *scip, SCIP_VAR **solution, int nInSolution, int cost, SCIP_VAR **pvar, SCIP_VAR **varlist, int n1, int nfrac, int *covered);
@@ -0,0 +1,392 @@
+/**@file   localsearch_dpd.c
+ * @brief  shift, swap and ejection-chain local search with O(1) move evaluation
+ **/
+#include <stdlib.h>
+#include <string.h>
+
+#include "localsearch_dpd.h"
+#include "probdata_dpd.h"
+
+#define LS_EPS 1e-6 /* minimal increase of the objective of an improving move */
+
+/** a move: up to two courses change their professors */
+typedef struct
+{
+  int course[2];  /**< courses moved */
+  int from[2];    /**< current professor of each course */
+  int to[2];      /**< new professor of each course */
+  int nshifts;    /**< number of courses moved */
+  double delta;   /**< change of the objective */
+  int dnunder;    /**< change of the number of professors below their minimal workload */
+} LS_Move;
+
+LocalSearchT *lsCreate(Instance *I)
+{
+  LocalSearchT *ls;
+  int n = I->nProfessors;
+  int m = I->nCourses;
+
+  ls = (LocalSearchT *) calloc(1, sizeof(LocalSearchT));
+  if (ls == NULL)
+    return NULL;
+  ls->I         = I;
+  ls->n         = n;
+  ls->m         = m;
+  ls->weight    = (double *) malloc(sizeof(double) * n * m);
+  ls->allowed   = (char *) malloc(n * m);
+  ls->locked    = (char *) malloc(m);
+  ls->assign    = (int *) malloc(sizeof(int) * m);
+  ls->ch1       = (int *) malloc(sizeof(int) * n);
+  ls->ch2       = (int *) malloc(sizeof(int) * n);
+  ls->prof_head = (int *) malloc(sizeof(int) * n);
+  ls->next      = (int *) malloc(sizeof(int) * m);
+  ls->prev      = (int *) malloc(sizeof(int) * m);
+  if (!ls->weight || !ls->allowed || !ls->locked || !ls->assign || !ls->ch1 || !ls->ch2 || !ls->prof_head || !ls->next || !ls->prev)
+  {
+    lsFree(&ls);
+    return NULL;
+  }
+  // objective coefficients of the original (maximized) problem; SCIP negates those of the transformed variables
+  for (int p = 0; p < n; p++)
+  {
+    for (int c = 0; c < m; c++)
+      ls->weight[p * m + c] = calculateAptitudeCoefficient(I, p, c);
+  }
+  lsAllowAll(ls);
+  return ls;
+}
+
+void lsFree(LocalSearchT **pls)
+{
+  LocalSearchT *ls = *pls;
+
+  if (ls == NULL)
+    return;
+  free(ls->weight);
+  free(ls->allowed);
+  free(ls->locked);
+  free(ls->assign);
+  free(ls->ch1);
+  free(ls->ch2);
+  free(ls->prof_head);
+  free(ls->next);
+  free(ls->prev);
+  free(ls);
+  *pls = NULL;
+}
+
+void lsSetZobrist(LocalSearchT *ls, const ZobristT *zobrist)
+{
+  ls->zobrist = zobrist;
+}
+
+void lsAllowAll(LocalSearchT *ls)
+{
+  memset(ls->allowed, 1, ls->n * ls->m);
+  memset(ls->locked, 0, ls->m);
+}
+
+void lsForbid(LocalSearchT *ls, int p, int c)
+{
+  ls->allowed[p * ls->m + c] = 0;
+}
+
+void lsLock(LocalSearchT *ls, int c)
+{
+  ls->locked[c] = 1;
+}
+
+/** removes course c from the list of its professor p */
+static void unlinkCourse(LocalSearchT *ls, int c, int p)
+{
+  if (ls->prev[c] >= 0)
+    ls->next[ls->prev[c]] = ls->next[c];
+  else
+    ls->prof_head[p] = ls->next[c];
+  if (ls->next[c] >= 0)
+    ls->prev[ls->next[c]] = ls->prev[c];
+}
+
+/** adds course c to the list of professor p */
+static void linkCourse(LocalSearchT *ls, int c, int p)
+{
+  ls->prev[c] = -1;
+  ls->next[c] = ls->prof_head[p];
+  if (ls->prof_head[p] >= 0)
+    ls->prev[ls->prof_head[p]] = c;
+  ls->prof_head[p] = c;
+}
+
+void lsLoad(LocalSearchT *ls, const int *assign)
+{
+  Instance *I = ls->I;
+  int p, c;
+
+  memcpy(ls->assign, assign, sizeof(int) * ls->m);
+  for (p = 0; p < ls->n; p++)
+  {
+    ls->ch1[p]       = 0;
+    ls->ch2[p]       = 0;
+    ls->prof_head[p] = -1;
+  }
+  ls->value = 0.0;
+  for (c = ls->m - 1; c >= 0; c--)
+  {
+    p = assign[c];
+    if (I->courses[c].semester == 1)
+      ls->ch1[p] += I->courses[c].workload;
+    else
+      ls->ch2[p] += I->courses[c].workload;
+    ls->value += ls->weight[p * ls->m + c];
+    linkCourse(ls, c, p);
+  }
+  ls->nunder = 0;
+  for (p = 0; p < ls->n; p++)
+  {
+    if (ls->ch1[p] + ls->ch2[p] < I->professors[p].minWorkload) ls->nunder++;
+  }
+  if (ls->zobrist != NULL)
+    ls->hash = zobristHash(ls->zobrist, ls->assign);
+}
+
+int lsIsFeasible(const LocalSearchT *ls)
+{
+  Instance *I = ls->I;
+  int c, p;
+
+  for (c = 0; c < ls->m; c++)
+  {
+    if (!ls->allowed[ls->assign[c] * ls->m + c])
+      return 0;
+  }
+  for (p = 0; p < ls->n; p++)
+  {
+    if (ls->ch1[p] > I->professors[p].maxWorkload1 || ls->ch2[p] > I->professors[p].maxWorkload2 ||
+        ls->ch1[p] + ls->ch2[p] < I->professors[p].minWorkload)
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * computes delta and dnunder of a move; returns 0 if the move is not allowed or exceeds a maximal workload.
+ * At most 3 professors are touched, so the workload changes are kept in small local arrays.
+ */
+static int evalMove(const LocalSearchT *ls, LS_Move *move)
+{
+  Instance *I = ls->I;
+  int prof[4], d1[4], d2[4], np = 0;
+  int s, k, c, p, load1, load2, wasunder, isunder;
+
+  move->delta = 0.0;
+  for (s = 0; s < move->nshifts; s++)
+  {
+    c = move->course[s];
+    if (ls->locked[c] || !ls->allowed[move->to[s] * ls->m + c] || move->from[s] == move->to[s])
+      return 0;
+    move->delta += ls->weight[move->to[s] * ls->m + c] - ls->weight[move->from[s] * ls->m + c];
+
+    // workload change of the professor losing (sign -1) and the one receiving (sign +1) the course
+    for (int sign = -1; sign <= 1; sign += 2)
+    {
+      p = sign < 0 ? move->from[s] : move->to[s];
+      for (k = 0; k < np && prof[k] != p; k++);
+      if (k == np)
+      {
+        prof[np] = p;
+        d1[np]   = 0;
+        d2[np]   = 0;
+        np++;
+      }
+      if (I->courses[c].semester == 1)
+        d1[k] += sign * I->courses[c].workload;
+      else
+        d2[k] += sign * I->courses[c].workload;
+    }
+  }
+
+  move->dnunder = 0;
+  for (k = 0; k < np; k++)
+  {
+    p     = prof[k];
+    load1 = ls->ch1[p] + d1[k];
+    load2 = ls->ch2[p] + d2[k];
+    if ((d1[k] > 0 && load1 > I->professors[p].maxWorkload1) || (d2[k] > 0 && load2 > I->professors[p].maxWorkload2))
+      return 0;
+    wasunder = ls->ch1[p] + ls->ch2[p] < I->professors[p].minWorkload;
+    isunder  = load1 + load2 < I->professors[p].minWorkload;
+    move->dnunder += isunder - wasunder;
+  }
+  return 1;
+}
+
+/** applies a move evaluated by evalMove */
+static void applyMove(LocalSearchT *ls, const LS_Move *move)
+{
+  Instance *I = ls->I;
+
+  for (int s = 0; s < move->nshifts; s++)
+  {
+    int c = move->course[s];
+    int p = move->from[s];
+    int q = move->to[s];
+
+    if (I->courses[c].semester == 1)
+    {
+      ls->ch1[p] -= I->courses[c].workload;
+      ls->ch1[q] += I->courses[c].workload;
+    }
+    else
+    {
+      ls->ch2[p] -= I->courses[c].workload;
+      ls->ch2[q] += I->courses[c].workload;
+    }
+    unlinkCourse(ls, c, p);
+    linkCourse(ls, c, q);
+    ls->assign[c] = q;
+    if (ls->zobrist != NULL)
+      ls->hash = zobristMove(ls->zobrist, ls->hash, c, p, q);
+  }
+  ls->value  += move->delta;
+  ls->nunder += move->dnunder;
+}
+
+/** 1 if move is better than best (fewer professors below the minimum, then larger objective) */
+static int isBetter(const LS_Move *move, const LS_Move *best)
+{
+  return move->dnunder < best->dnunder || (move->dnunder == best->dnunder && move->delta > best->delta + LS_EPS);
+}
+
+/**
+ * evaluates a move: with first improvement, an improving move is applied at once (returns 1); with best improvement,
+ * it replaces best if it is better
+ */
+static int consider(LocalSearchT *ls, LS_Strategy strategy, LS_Move *move, LS_Move *best)
+{
+  if (!evalMove(ls, move) || !isBetter(move, best))
+    return 0;
+  if (strategy == LS_FIRST_IMPROVEMENT)
+  {
+    applyMove(ls, move);
+    return 1;
+  }
+  *best = *move;
+  return 0;
+}
+
+static int scanShift(LocalSearchT *ls, LS_Strategy strategy, LS_Move *best)
+{
+  LS_Move move;
+  int applied = 0;
+
+  move.nshifts = 1;
+  for (int c = 0; c < ls->m; c++)
+  {
+    if (ls->locked[c]) continue;
+    for (int q = 0; q < ls->n; q++)
+    {
+      move.course[0] = c;
+      move.from[0]   = ls->assign[c];
+      move.to[0]     = q;
+      applied += consider(ls, strategy, &move, best);
+    }
+  }
+  return applied;
+}
+
+static int scanSwap(LocalSearchT *ls, LS_Strategy strategy, LS_Move *best)
+{
+  LS_Move move;
+  int applied = 0;
+
+  move.nshifts = 2;
+  for (int c1 = 0; c1 < ls->m; c1++)
+  {
+    if (ls->locked[c1]) continue;
+    for (int c2 = c1 + 1; c2 < ls->m; c2++)
+    {
+      if (ls->locked[c2] || ls->assign[c1] == ls->assign[c2]) continue;
+      move.course[0] = c1;
+      move.from[0]   = ls->assign[c1];
+      move.to[0]     = ls->assign[c2];
+      move.course[1] = c2;
+      move.from[1]   = ls->assign[c2];
+      move.to[1]     = ls->assign[c1];
+      applied += consider(ls, strategy, &move, best);
+    }
+  }
+  return applied;
+}
+
+static int scanEjection(LocalSearchT *ls, LS_Strategy strategy, LS_Move *best)
+{
+  Instance *I = ls->I;
+  LS_Move move, first;
+  int applied = 0, moved;
+
+  move.nshifts  = 2;
+  first.nshifts = 1;
+  for (int c1 = 0; c1 < ls->m; c1++)
+  {
+    if (ls->locked[c1]) continue;
+    int p1 = ls->assign[c1];
+
+    // after a move, the course lists of the professors changed: continue with the next course
+    moved = 0;
+    for (int p2 = 0; p2 < ls->n && !moved; p2++)
+    {
+      // chains start with a move that increases the objective and only fails because p2 is full
+      if (p2 == p1 || !ls->allowed[p2 * ls->m + c1] || ls->weight[p2 * ls->m + c1] <= ls->weight[p1 * ls->m + c1] + LS_EPS)
+        continue;
+      first.course[0] = c1;
+      first.from[0]   = p1;
+      first.to[0]     = p2;
+      if (evalMove(ls, &first))
+        continue;  // plain shift, covered by scanShift
+
+      for (int c2 = ls->prof_head[p2]; c2 >= 0 && !moved; c2 = ls->next[c2])
+      {
+        if (I->courses[c2].semester != I->courses[c1].semester) continue;
+        for (int p3 = 0; p3 < ls->n && !moved; p3++)
+        {
+          move.course[0] = c1;
+          move.from[0]   = p1;
+          move.to[0]     = p2;
+          move.course[1] = c2;
+          move.from[1]   = p2;
+          move.to[1]     = p3;
+          moved          = consider(ls, strategy, &move, best);
+        }
+      }
+    }
+    applied += moved;
+  }
+  return applied;
+}
+
+int lsRun(LocalSearchT *ls, LS_Strategy strategy, int neighborhoods, int maxmoves)
+{
+  LS_Move best;
+  int moves = 0, applied;
+
+  do
+  {
+    best.nshifts = 0;
+    best.delta   = 0.0;
+    best.dnunder = 0;
+    applied      = 0;
+    if (neighborhoods & LS_SHIFT) applied += scanShift(ls, strategy, &best);
+    if (neighborhoods & LS_SWAP) applied += scanSwap(ls, strategy, &best);
+    // ejection chains are expensive: only when the simple moves are exhausted
+    if ((neighborhoods & LS_EJECTION) && applied == 0 && best.nshifts == 0) applied += scanEjection(ls, strategy, &best);
+
+    if (strategy == LS_BEST_IMPROVEMENT && best.nshifts > 0)
+    {
+      applyMove(ls, &best);
+      applied = 1;
+    }
+    moves += applied;
+  } while (applied > 0 && (maxmoves <= 0 || moves < maxmoves));
+
+  return moves;
+}
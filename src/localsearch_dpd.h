@@ -0,0 +1,92 @@
+/**@file   localsearch_dpd.h
+ * @brief  local search on complete assignments (professor of each course), used by the GRASP and LNS heuristics
+ *
+ * Neighborhoods:
+ *   - shift: move one course to another professor;
+ *   - swap: exchange two courses between their professors;
+ *   - ejection chain: move a course to a professor that has no room left for it in that semester, and make room by
+ *     moving one of that professor's courses of the same semester to a third professor (possibly the first one).
+ *     Only first moves that increase the objective are extended into chains.
+ * A move is improving if it keeps every semester workload within its maximum and either reduces the number of
+ * professors below their minimal workload, or keeps that number and increases the objective. Workloads, the objective
+ * value and the number of professors below the minimum are kept up to date, so each move is evaluated in O(1). With
+ * Zobrist keys (lsSetZobrist), the hash of the assignment is kept up to date too.
+ **/
+#ifndef __LOCALSEARCH_DPD__
+#define __LOCALSEARCH_DPD__
+
+#include "problem.h"
+#include "zobrist_dpd.h"
+
+/* neighborhoods (bitmask) */
+#define LS_SHIFT 1
+#define LS_SWAP 2
+#define LS_EJECTION 4
+#define LS_ALL (LS_SHIFT | LS_SWAP | LS_EJECTION)
+
+/** acceptance strategy */
+typedef enum
+{
+  LS_FIRST_IMPROVEMENT = 0, /**< apply each improving move as soon as it is found */
+  LS_BEST_IMPROVEMENT  = 1  /**< scan the whole neighborhood and apply the best move */
+} LS_Strategy;
+
+/** state of the local search: the instance data it needs and the current assignment */
+typedef struct
+{
+  Instance *I;             /**< instance */
+  int n;                   /**< number of professors */
+  int m;                   /**< number of courses */
+  double *weight;          /**< objective coefficient of x_p_c, at p * m + c */
+  char *allowed;           /**< 1 if x_p_c may be set to 1, at p * m + c */
+  char *locked;            /**< 1 if the course may not change its professor */
+  int *assign;             /**< professor of each course */
+  int *ch1;                /**< workload of each professor in the first semester */
+  int *ch2;                /**< workload of each professor in the second semester */
+  int *prof_head;          /**< first course of each professor (-1 = none) */
+  int *next;               /**< next course of the same professor */
+  int *prev;               /**< previous course of the same professor */
+  double value;            /**< objective value of the assignment (without offset) */
+  int nunder;              /**< number of professors below their minimal workload */
+  const ZobristT *zobrist; /**< keys of the hash of the assignment (NULL = no hash) */
+  uint64_t hash;           /**< Zobrist hash of the assignment (if zobrist != NULL) */
+} LocalSearchT;
+
+/**
+ * creates the local search for an instance: all assignments allowed, and the weights are the objective coefficients of
+ * the original problem (maximized), computed from the instance. The coefficients of the transformed variables are not
+ * used: SCIP negates them to minimize. Returns NULL if there is no memory.
+ */
+LocalSearchT *lsCreate(Instance *I);
+
+/** frees the local search */
+void lsFree(LocalSearchT **pls);
+
+/** keeps the Zobrist hash of the assignment up to date with the given keys (NULL = no hash) */
+void lsSetZobrist(LocalSearchT *ls, const ZobristT *zobrist);
+
+/** allows every assignment and unlocks every course */
+void lsAllowAll(LocalSearchT *ls);
+
+/** forbids assigning course c to professor p */
+void lsForbid(LocalSearchT *ls, int p, int c);
+
+/** keeps course c with its current professor */
+void lsLock(LocalSearchT *ls, int c);
+
+/** loads a complete assignment (professor of each course) and computes its workloads and objective value */
+void lsLoad(LocalSearchT *ls, const int *assign);
+
+/**
+ * exact feasibility of the loaded assignment for the model, in O(n + m): every course has an allowed professor, every
+ * semester workload is within its maximum and every professor reaches its minimal workload
+ */
+int lsIsFeasible(const LocalSearchT *ls);
+
+/**
+ * applies improving moves of the given neighborhoods until none is left (or maxmoves moves, if maxmoves > 0).
+ * Ejection chains are only tried when no shift or swap improves. Returns the number of moves applied.
+ */
+int lsRun(LocalSearchT *ls, LS_Strategy strategy, int neighborhoods, int maxmoves);
+
+#endif
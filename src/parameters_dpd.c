@@ -1,46 +1,201 @@
 #include "parameters_dpd.h"
 #include "probdata_dpd.h"
+#include <limits.h>
 #include <scip/scip.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>
 #include <time.h>
 
-char output_path[512]  = "";
-char current_path[512] = ".";
+typedef struct
+{
+  const char *description;
+  const char *param_name;
+  void *param_var;
+  enum
+  {
+    INT,
+    DOUBLE,
+    STRING
+  } type;
+  int ilb;
+  int iub;
+  double dlb;
+  double dub;
+  int idefault;
+  double ddefault;
+  const char *sdefault; /* default of STRING parameters (NULL = empty) */
+  size_t ssize;         /* size of the buffer of STRING parameters */
+} settingsT;
 
-void init_output_folder()
+/**
+ * fill the settings table of pparam (if parameters is not NULL) and return its number of entries
+ **/
+static int getSettings(parametersT *pparam, settingsT *parameters)
+{
+  settingsT settings[] = {
+          {"time limit", "--time", &(pparam->time_limit), INT, 0, 7200, 0, 0, 1800, 0, NULL, 0},
+          {"display freq", "--display", &(pparam->display_freq), INT, -1, MAXINT, 0, 0, 50, 0, NULL, 0},
+          {"nodes limit", "--nodes", &(pparam->nodes_limit), INT, -1, MAXINT, 0, 0, -1, 0, NULL, 0},
+          {"param stamp", "--param_stamp", pparam->parameter_stamp, STRING, 0, 0, 0, 0, 0, 0, NULL, sizeof(pparam->parameter_stamp)},
+          {"heur rounding", "--heur_rounding", &(pparam->heur_rounding), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"heur bad Solution", "--heur_bad_sol", &(pparam->heur_bad_sol), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"heur lns", "--heur_lns", &(pparam->heur_lns), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"heur grasp", "--heur_grasp", &(pparam->heur_grasp), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"lns perc", "--lns_perc", &(pparam->lns_perc), DOUBLE, 0, 0, 0, 1.0, 0, 0.3, NULL, 0},
+          {"lns_time", "--lns_time", &(pparam->lns_time), INT, 0, 3600, 0, 0, 30, 0, NULL, 0},
+          {"heur round freq", "--heur_round_freq", &(pparam->heur_round_freq), INT, 0, MAXINT, 0, 0, 1, 0, NULL, 0},
+          {"heur round maxdepth", "--heur_round_depth", &(pparam->heur_round_maxdepth), INT, -1, MAXINT, 0, 0, -1, 0, NULL, 0},
+          {"heur round freqofs", "--heur_round_freqofs", &(pparam->heur_round_freqofs), INT, 0, MAXINT, 0, 0, 0, 0, NULL, 0},
+          {"lns order", "--lns_order", pparam->lns_order, STRING, 0, 0, 0, 0, 0, 0, "decrescente", sizeof(pparam->lns_order)},
+          {"area penalty", "--penalty", &(pparam->area_penalty), INT, -100, MAXINT, 0, 0, 0, 0, NULL, 0},
+          {"grasp max iterations", "--grasp_max_iter", &(pparam->grasp_max_iter), INT, 1, 1000, 0, 0, 10, 0, NULL, 0},
+          {"grasp alpha", "--grasp_alpha", &(pparam->grasp_alpha), DOUBLE, 0, 0, 0.0, 1.0, 0, 0.4, NULL, 0},
+          {"grasp local search", "--grasp_local_search", &(pparam->grasp_local_search), INT, 0, 1, 0, 0, 1, 0, NULL, 0},
+          {"grasp reactive", "--grasp_reactive", &(pparam->grasp_reactive), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"grasp path relinking", "--grasp_path_relinking", &(pparam->grasp_path_relinking), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"grasp elite pool", "--grasp_elite_pool", &(pparam->grasp_elite_pool), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"grasp threads", "--grasp_threads", &(pparam->grasp_threads), INT, 1, 64, 0, 0, 1, 0, NULL, 0},
+          {"grasp lp guided", "--grasp_lp_guided", &(pparam->grasp_lp_guided), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"grasp lp weight", "--grasp_lp_weight", &(pparam->grasp_lp_weight), DOUBLE, 0, 0, 0.0, 1.0, 0, 0.5, NULL, 0},
+          {"grasp adaptive scheduling", "--grasp_adaptive", &(pparam->grasp_adaptive), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"local search strategy", "--ls_strategy", &(pparam->ls_strategy), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"local search neighborhoods", "--ls_neighborhoods", &(pparam->ls_neighborhoods), INT, 1, 7, 0, 0, 7, 0, NULL, 0},
+          {"lns local search", "--lns_local_search", &(pparam->lns_local_search), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"scip settings profile", "--profile", pparam->profile, STRING, 0, 0, 0, 0, 0, 0, "legacy", sizeof(pparam->profile)},
+          {"portfolio threads", "--threads", &(pparam->threads), INT, 1, MAXINT, 0, 0, 1, 0, NULL, 0},
+          {"checkpoint frequency (s)", "--checkpoint_freq", &(pparam->checkpoint_freq), INT, 0, 86400, 0, 0, 0, 0, NULL, 0},
+          {"resume from checkpoint", "--resume", pparam->resume, STRING, 0, 0, 0, 0, 0, 0, "none", sizeof(pparam->resume)},
+          {"incumbent log", "--incumbent_log", &(pparam->incumbent_log), INT, 0, 1, 0, 0, 0, 0, NULL, 0},
+          {"random seed", "--seed", &(pparam->seed), INT, 0, INT_MAX, 0, 0, 0, 0, NULL, 0},
+          {"solve mode", "--mode", pparam->mode, STRING, 0, 0, 0, 0, 0, 0, "exact", sizeof(pparam->mode)},
+          {"heuristic mode time (s)", "--heuristic_time", &(pparam->heuristic_time), DOUBLE, 0, 0, 0.001, 7200.0, 0, 1.0, NULL, 0}};
+
+  if (parameters != NULL)
+    memcpy(parameters, settings, sizeof(settings));
+  return sizeof(settings) / sizeof(settings[0]);
+}
+
+/**
+ * create the output folder output/<date-time> of a run and store it in pparam->output_path
+ **/
+void init_output_folder(parametersT *pparam)
 {
   time_t now         = time(NULL);
   struct tm *tm_info = localtime(&now);
-  strftime(output_path, sizeof(output_path), "output/%Y-%m-%d_%H:%M:%S", tm_info);
-  mkdir(output_path, 0777);
+  strftime(pparam->output_path, sizeof(pparam->output_path), "output/%Y-%m-%d_%H:%M:%S", tm_info);
+  mkdir(pparam->output_path, 0777);
 }
 
 /**
- * set default+user parameters
+ * set the default value of all parameters (no output folder)
  **/
-int setParameters(int argc, char **argv, parametersT *pparam)
+void setDefaultParameters(parametersT *pparam)
 {
-  typedef struct
+  settingsT parameters[getSettings(pparam, NULL)];
+  int i, total_parameters;
+
+  total_parameters = getSettings(pparam, parameters);
+  for (i = 0; i < total_parameters; i++)
   {
-    const char *description;
-    const char *param_name;
-    void *param_var;
-    enum
-    {
-      INT,
-      DOUBLE,
-      STRING
-    } type;
-    int ilb;
-    int iub;
-    double dlb;
-    double dub;
-    int idefault;
-    double ddefault;
-  } settingsT;
+    if (parameters[i].type == INT)
+      *((int *) (parameters[i].param_var)) = parameters[i].idefault;
+    else if (parameters[i].type == DOUBLE)
+      *((double *) (parameters[i].param_var)) = parameters[i].ddefault;
+    else  // STRING parameters are fixed-size buffers (parameter_stamp starts empty)
+      strcpy((char *) parameters[i].param_var, parameters[i].sdefault != NULL ? parameters[i].sdefault : "");
+  }
+  // parameters without command line option
+  pparam->heur_rf        = 0;
+  pparam->output_path[0] = '\0';
+}
+
+/**
+ * set one parameter given its option name (e.g. "--time") and value. Return 1 if the value is valid, 0 otherwise
+ **/
+int setParameter(parametersT *pparam, const char *name, const char *value)
+{
+  settingsT parameters[getSettings(pparam, NULL)];
+  int j, ivalue, total_parameters;
+  double dvalue;
+
+  total_parameters = getSettings(pparam, parameters);
+  for (j = 0; j < total_parameters && strcmp(name, parameters[j].param_name); j++);
+  if (j >= total_parameters || value == NULL)
+  {
+    printf("\nParameter (%s) invalid or uncompleted.", name);
+    return 0;
+  }
+  switch (parameters[j].type)
+  {
+    case INT:
+      ivalue = atoi(value);
+      if (ivalue < parameters[j].ilb || ivalue > parameters[j].iub)
+      {
+        printf("\nParameter (%s) value (%d) out of range [%d,%d].", name, ivalue, parameters[j].ilb, parameters[j].iub);
+        return 0;
+      }
+      *((int *) (parameters[j].param_var)) = ivalue;
+      break;
+    case DOUBLE:
+      dvalue = atof(value);
+      if (dvalue < parameters[j].dlb || dvalue > parameters[j].dub)
+      {
+        printf("\nParameter (%s) value (%lf) out of range [%lf,%lf].", name, dvalue, parameters[j].dlb, parameters[j].dub);
+        return 0;
+      }
+      *((double *) (parameters[j].param_var)) = dvalue;
+      break;
+    case STRING:
+      if (strlen(value) >= parameters[j].ssize)
+      {
+        printf("\nParameter (%s) value (%s) is too long (max %d chars).", name, value, (int) parameters[j].ssize - 1);
+        return 0;
+      }
+      if (strcmp(parameters[j].param_name, "--lns_order") == 0 && strcmp(value, "crescente") != 0 && strcmp(value, "decrescente") != 0)
+      {
+        printf("\nParameter (%s) value (%s) must be 'crescente' or 'decrescente'.", name, value);
+        return 0;
+      }
+      if (strcmp(parameters[j].param_name, "--mode") == 0 && strcmp(value, "exact") != 0 && strcmp(value, "heuristic") != 0)
+      {
+        printf("\nParameter (%s) value (%s) must be 'exact' or 'heuristic'.", name, value);
+        return 0;
+      }
+      if (strcmp(parameters[j].param_name, "--profile") == 0 && !profileExists(value))
+      {
+        printf("\nParameter (%s) value (%s) must be 'legacy', 'auto' or the name of a file in %s/.", name, value, PROFILE_DIR);
+        return 0;
+      }
+      strcpy((char *) parameters[j].param_var, value);
+  }
+  return 1;
+}
+
+/**
+ * check if a SCIP settings profile is known: the built-in "legacy" and "auto" or a file PROFILE_DIR/<name>.set
+ **/
+int profileExists(const char *profile)
+{
+  char filename[SCIP_MAXSTRLEN];
+  FILE *fin;
 
+  if (!strcmp(profile, "legacy") || !strcmp(profile, "auto"))
+    return 1;
+
+  (void) SCIPsnprintf(filename, SCIP_MAXSTRLEN, "%s/%s.set", PROFILE_DIR, profile);
+  fin = fopen(filename, "r");
+  if (!fin)
+    return 0;
+  fclose(fin);
+  return 1;
+}
+
+/**
+ * set default+user parameters
+ **/
+int setParameters(int argc, char **argv, parametersT *pparam)
+{
   enum
   {
     time_limit,
@@ -57,37 +212,37 @@ int setParameters(int argc, char **argv, parametersT *pparam)
     lns_order,
     grasp_max_iter,
     grasp_alpha,
-    grasp_local_search
+    grasp_local_search,
+    grasp_reactive,
+    grasp_path_relinking,
+    grasp_elite_pool,
+    grasp_threads,
+    grasp_lp_guided,
+    grasp_lp_weight,
+    grasp_adaptive,
+    ls_strategy,
+    ls_neighborhoods,
+    lns_local_search,
+    profile,
+    threads,
+    checkpoint_freq,
+    resume,
+    incumbent_log,
+    seed,
+    mode,
+    heuristic_time
   };
 
-  settingsT parameters[] = {
-          {"time limit", "--time", &(param.time_limit), INT, 0, 7200, 0, 0, 1800, 0},
-          {"display freq", "--display", &(param.display_freq), INT, -1, MAXINT, 0, 0, 50, 0},
-          {"nodes limit", "--nodes", &(param.nodes_limit), INT, -1, MAXINT, 0, 0, -1, 0},
-          {"param stamp", "--param_stamp", param.parameter_stamp, STRING, 0, 0, 0, 0, 0, 0},
-          {"heur rounding", "--heur_rounding", &(param.heur_rounding), INT, 0, 1, 0, 0, 0, 0},
-          {"heur bad Solution", "--heur_bad_sol", &(param.heur_bad_sol), INT, 0, 1, 0, 0, 0, 0},
-          {"heur lns", "--heur_lns", &(param.heur_lns), INT, 0, 1, 0, 0, 0, 0},
-          {"heur grasp", "--heur_grasp", &(param.heur_grasp), INT, 0, 1, 0, 0, 0, 0},
-          {"lns perc", "--lns_perc", &(param.lns_perc), DOUBLE, 0, 0, 0, 1.0, 0, 0.3},
-          {"lns_time", "--lns_time", &(param.lns_time), INT, 0, 3600, 0, 0, 30, 0},
-          {"heur round freq", "--heur_round_freq", &(param.heur_round_freq), INT, 0, MAXINT, 0, 0, 1, 0},
-          {"heur round maxdepth", "--heur_round_depth", &(param.heur_round_maxdepth), INT, -1, MAXINT, 0, 0, -1, 0},
-          {"heur round freqofs", "--heur_round_freqofs", &(param.heur_round_freqofs), INT, 0, MAXINT, 0, 0, 0, 0},
-          {"lns order", "--lns_order", param.lns_order, STRING, 0, 0, 0, 0, 0, 0},
-          {"area penalty", "--penalty", &(param.area_penalty), INT, -100, MAXINT, 0, 0, 0, 0},
-          {"grasp max iterations", "--grasp_max_iter", &(param.grasp_max_iter), INT, 1, 1000, 0, 0, 10, 0},
-          {"grasp alpha", "--grasp_alpha", &(param.grasp_alpha), DOUBLE, 0, 0, 0.0, 1.0, 0, 0.4},
-          {"grasp local search", "--grasp_local_search", &(param.grasp_local_search), INT, 0, 1, 0, 0, 1, 0}};
   int i, j, ivalue, error;
   double dvalue;
   FILE *fin;
 
-  int total_parameters = sizeof(parameters) / sizeof(parameters[0]);
-
   if (pparam == NULL)
     return 0;
 
+  settingsT parameters[getSettings(pparam, NULL)];
+  int total_parameters = getSettings(pparam, parameters);
+
   // check arguments
   if (argc < 2)
   {
@@ -128,84 +283,14 @@ int setParameters(int argc, char **argv, parametersT *pparam)
   fclose(fin);
 
   // set default parameters value
-  for (i = 0; i < total_parameters; i++)
-  {
-    if (parameters[i].type == INT)
-      *((int *) (parameters[i].param_var)) = parameters[i].idefault;
-    else if (parameters[i].type == DOUBLE)
-      *((double *) (parameters[i].param_var)) = parameters[i].ddefault;
-    else if (strcmp(parameters[i].param_name, "--output_path") == 0)
-      strcpy((char *) parameters[i].param_var, "output");  // default value for output_path
-    else if (strcmp(parameters[i].param_name, "--param_stamp") == 0)
-      strcpy((char *) parameters[i].param_var, "");  // initialize parameter_stamp as empty string
-    else if (strcmp(parameters[i].param_name, "--lns_order") == 0)
-      strcpy((char *) parameters[i].param_var, "decrescente");  // default value for lns_order
-    else
-      *((char **) (parameters[i].param_var)) = "";
-  }
+  setDefaultParameters(pparam);
 
-  init_output_folder();
+  init_output_folder(pparam);
 
   // set user parameters value
   error = 0;
   for (i = 2; i < argc && !error; i += 2)
-  {
-    for (j = 0; j < total_parameters && strcmp(argv[i], parameters[j].param_name); j++);
-    if (j >= total_parameters || i == argc - 1)
-    {
-      printf("\nParameter (%s) invalid or uncompleted.", argv[i]);
-      error = 1;
-    }
-    else
-    {
-      switch (parameters[j].type)
-      {
-        case INT:
-          ivalue = atoi(argv[i + 1]);
-          if (ivalue < parameters[j].ilb || ivalue > parameters[j].iub)
-          {
-            printf("\nParameter (%s) value (%d) out of range [%d,%d].", argv[i], ivalue, parameters[j].ilb, parameters[j].iub);
-            error = 1;
-            //          break;
-          }
-          else
-          {
-            *((int *) (parameters[j].param_var)) = ivalue;
-          }
-          break;
-        case DOUBLE:
-          dvalue = atof(argv[i + 1]);
-          if (dvalue < parameters[j].dlb || dvalue > parameters[j].dub)
-          {
-            printf("\nParameter (%s) value (%lf) out of range [%lf,%lf].", argv[i], dvalue, parameters[j].dlb, parameters[j].dub);
-            error = 1;
-            //          break;
-          }
-          else
-          {
-            *((double *) (parameters[j].param_var)) = dvalue;
-          }
-          break;
-        case STRING:
-          if (strcmp(parameters[j].param_name, "--output_path") == 0)
-            strcpy((char *) parameters[j].param_var, argv[i + 1]);
-          else if (strcmp(parameters[j].param_name, "--param_stamp") == 0)
-            strcpy((char *) parameters[j].param_var, argv[i + 1]);
-          else if (strcmp(parameters[j].param_name, "--lns_order") == 0)
-          {
-            if (strcmp(argv[i + 1], "crescente") != 0 && strcmp(argv[i + 1], "decrescente") != 0)
-            {
-              printf("\nParameter (%s) value (%s) must be 'crescente' or 'decrescente'.", argv[i], argv[i + 1]);
-              error = 1;
-            }
-            else
-              strcpy((char *) parameters[j].param_var, argv[i + 1]);
-          }
-          else
-            *((char **) (parameters[j].param_var)) = argv[i + 1];
-      }
-    }
-  }
+    error = !setParameter(pparam, argv[i], i < argc - 1 ? argv[i + 1] : NULL);
 
   // print parameters
   printf("\n\n----------------------------\nParameters settings");
@@ -221,12 +306,7 @@ int setParameters(int argc, char **argv, parametersT *pparam)
         printf("%lf - value = %lf", parameters[i].ddefault, *((double *) parameters[i].param_var));
         break;
       case STRING:
-        if (strcmp(parameters[i].param_name, "--param_stamp") == 0)
-          printf("(null) - value = %s", (char *) parameters[i].param_var);
-        else if (strcmp(parameters[i].param_name, "--lns_order") == 0)
-          printf("decrescente - value = %s", (char *) parameters[i].param_var);
-        else
-          printf("(null) - value = %s", *((char **) parameters[i].param_var));
+        printf("%s - value = %s", parameters[i].sdefault != NULL ? parameters[i].sdefault : "(null)", (char *) parameters[i].param_var);
         break;
     }
   }
@@ -237,10 +317,10 @@ int setParameters(int argc, char **argv, parametersT *pparam)
     FILE *fout;
     char foutname[SCIP_MAXSTRLEN];
 
-    if (strlen(param.parameter_stamp) > 0)
+    if (strlen(pparam->parameter_stamp) > 0)
     {
       // complete the fullname of the parameters stamp file
-      sprintf(foutname, "%s/%s", output_path, param.parameter_stamp);
+      sprintf(foutname, "%s/%s", pparam->output_path, pparam->parameter_stamp);
     }
     else
     {
@@ -248,9 +328,9 @@ int setParameters(int argc, char **argv, parametersT *pparam)
       struct tm *ct;
       const time_t t = time(NULL);
       ct             = localtime(&t);
-      snprintf(param.parameter_stamp, sizeof(param.parameter_stamp), "d%d%.2d%.2dh%.2d%.2d%.2d", ct->tm_year + 1900, ct->tm_mon, ct->tm_mday, ct->tm_hour, ct->tm_min, ct->tm_sec);
+      snprintf(pparam->parameter_stamp, sizeof(pparam->parameter_stamp), "d%d%.2d%.2dh%.2d%.2d%.2d", ct->tm_year + 1900, ct->tm_mon, ct->tm_mday, ct->tm_hour, ct->tm_min, ct->tm_sec);
 
-      sprintf(foutname, "%s/%s", output_path, param.parameter_stamp);
+      sprintf(foutname, "%s/%s", pparam->output_path, pparam->parameter_stamp);
     }
     // check if the stamp already exists
     fout = fopen(foutname, "r");
@@ -272,12 +352,7 @@ int setParameters(int argc, char **argv, parametersT *pparam)
             fprintf(fout, "%lf\n", *((double *) parameters[i].param_var));
             break;
           case STRING:
-            if (strcmp(parameters[i].param_name, "--param_stamp") == 0)
-              fprintf(fout, "%s\n", (char *) parameters[i].param_var);
-            else if (strcmp(parameters[i].param_name, "--lns_order") == 0)
-              fprintf(fout, "%s\n", (char *) parameters[i].param_var);
-            else
-              fprintf(fout, "%s\n", *((char **) parameters[i].param_var));
+            fprintf(fout, "%s\n", (char *) parameters[i].param_var);
             break;
         }
       }
@@ -286,11 +361,18 @@ int setParameters(int argc, char **argv, parametersT *pparam)
     else
     {
       // check if the stamp is valid
+      // string values are read into a buffer as large as the largest STRING parameter, with a width-limited conversion
+      size_t ssize = 1;
+      char sformat[32];
       char param_name[100];
-      char svalue[100];
+      for (j = 0; j < total_parameters; j++)
+        if (parameters[j].type == STRING && parameters[j].ssize > ssize)
+          ssize = parameters[j].ssize;
+      char svalue[ssize];
+      snprintf(sformat, sizeof(sformat), "%%%zus\n", ssize - 1);
       while (!feof(fout))
       {
-        fscanf(fout, "%s", param_name);
+        fscanf(fout, "%99s", param_name);
         for (j = 0; j < total_parameters && strcmp(param_name, parameters[j].param_name); j++);
         if (j >= total_parameters)
         {
@@ -329,30 +411,11 @@ int setParameters(int argc, char **argv, parametersT *pparam)
               }
               break;
             case STRING:
-              fscanf(fout, "%s\n", svalue);
-              if (strcmp(parameters[j].param_name, "--param_stamp") == 0)
-              {
-                if (strcmp(svalue, (char *) parameters[j].param_var))
-                {
-                  printf("\nParameter (%s) value (%s) differs to saved value = %s.", param_name, svalue, (char *) parameters[j].param_var);
-                  error = 1;
-                }
-              }
-              else if (strcmp(parameters[j].param_name, "--lns_order") == 0)
+              fscanf(fout, sformat, svalue);
+              if (strcmp(svalue, (char *) parameters[j].param_var))
               {
-                if (strcmp(svalue, (char *) parameters[j].param_var))
-                {
-                  printf("\nParameter (%s) value (%s) differs to saved value = %s.", param_name, svalue, (char *) parameters[j].param_var);
-                  error = 1;
-                }
-              }
-              else
-              {
-                if (strcmp(svalue, *((char **) (parameters[j].param_var))))
-                {
-                  printf("\nParameter (%s) value (%s) differs to saved value = %s.", param_name, svalue, *((char **) (parameters[j].param_var)));
-                  error = 1;
-                }
+                printf("\nParameter (%s) value (%s) differs to saved value = %s.", param_name, svalue, (char *) parameters[j].param_var);
+                error = 1;
               }
               break;
           }
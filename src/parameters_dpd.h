@@ -2,6 +2,9 @@
 #define __SCIP_PARAMETERS_MOCHILA__
 
 #define MAXINT 1000
+#define PROFILE_DIR "settings"     /* folder of the SCIP settings profiles (<profile>.set) */
+#define PROFILE_SMALL_COURSES 125  /* profile "auto": up to this number of courses uses "tight-bound" (above, "fast-primal") */
+#define CURRENT_PATH "."           /* prefix of the output file names */
 typedef struct
 {
   // global settings
@@ -12,6 +15,29 @@ typedef struct
   // parameter stamp
   char parameter_stamp[100]; /* fixed-size buffer for parameter stamp */
 
+  // output
+  char output_path[512]; /* folder of the output files ("" = no output files). Set by setParameters to output/<date-time> */
+
+  // portfolio
+  int threads; /* number of portfolio workers solving in parallel threads (1 = sequential solve). Default = 1 */
+
+  // checkpoint
+  int checkpoint_freq; /* seconds between checkpoints written to the output directory (0 = no checkpoint). Default = 0 */
+  char resume[512];    /* checkpoint file to resume from ("none" = start from scratch). Default = "none" */
+
+  // incumbent log
+  int incumbent_log; /* 1 = append each new best solution to <instance>.incumbents in the output directory. Default = 0 */
+
+  // randomization
+  int seed; /* seed of the random streams of the heuristics and of SCIP (randomization/randomseedshift). Default = 0 */
+
+  // heuristic mode
+  char mode[16];         /* "exact" = branch-and-bound with SCIP; "heuristic" = GRASP and local search only, no SCIP model. Default = "exact" */
+  double heuristic_time; /* wall-clock budget (in sec) of the heuristic mode. Default = 1 */
+
+  // SCIP settings
+  char profile[32]; /* SCIP settings profile: "legacy", "auto" or the name of a settings/<profile>.set file. Default = "legacy" */
+
   // primal heuristic
   int heur_bad_sol;
   int heur_rounding;
@@ -23,17 +49,30 @@ typedef struct
   double lns_perc;
   int lns_time;
   char lns_order[20]; /* order for LNS candidates: "crescente" or "decrescente". Default = "decrescente" */
+  int lns_local_search; /* 1 = polish the sub-SCIP solution of LNS with the local search. Default = 0 */
   int heur_rf;
   int heur_grasp;
 
   // GRASP parameters
-  int grasp_max_iter;     // max iterations for GRASP. Default = 10
-  double grasp_alpha;     // alpha parameter for GRASP RCL. Default = 0.4 
-  int grasp_local_search; // enable/disable local search in GRASP. Default = 1
+  int grasp_max_iter;       // max iterations for GRASP. Default = 10
+  double grasp_alpha;       // alpha parameter for GRASP RCL. Default = 0.4 
+  int grasp_local_search;   // enable/disable local search in GRASP. Default = 1
+  int grasp_reactive;       // 1 = reactive GRASP: alpha drawn from a distribution learned during the solve. Default = 0
+  int grasp_path_relinking; // 1 = keep elite GRASP solutions and relink them at the end of each call. Default = 0
+  int grasp_elite_pool;     // 1 = keep the best distinct GRASP solutions across calls and seed constructions from them. Default = 0
+  int grasp_threads;        // number of threads sharing the GRASP iterations of each call. Default = 1
+  int grasp_lp_guided;      // 1 = blend the LP value of the node into the GRASP scores and assign LP-integral courses first. Default = 0
+  double grasp_lp_weight;   // weight of the LP value in the blended GRASP score (0..1). Default = 0.5
+  int grasp_adaptive;       // 1 = skip GRASP calls with exponential backoff while it does not improve the incumbent. Default = 0
+
+  // local search (GRASP and LNS)
+  int ls_strategy;      // 0 = first improvement, 1 = best improvement. Default = 0
+  int ls_neighborhoods; // neighborhoods (bitmask): 1 = shift, 2 = swap, 4 = ejection chain. Default = 7
 } parametersT;
 
 int setParameters(int argc, char **argv, parametersT *Param);
-
-extern parametersT param;
-extern char current_path[512];
+void setDefaultParameters(parametersT *pparam);
+int setParameter(parametersT *pparam, const char *name, const char *value);
+void init_output_folder(parametersT *pparam);
+int profileExists(const char *profile);
 #endif
@@ -0,0 +1,215 @@
+/**@file   portfolio_dpd.c
+ * @brief  concurrent portfolio solve with shared incumbents
+ *
+ * Every worker thread creates its own SCIP (configScip), applies its preset, includes the portfolio heuristic that
+ * exchanges incumbents through a SharedIncumbent and solves. SCIP instances are independent, so no SCIP data is
+ * shared between threads; only the SharedIncumbent is, protected by its mutex.
+ **/
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dpd.h"
+#include "event_incumbent.h"
+#include "heur_portfolio.h"
+#include "portfolio_dpd.h"
+#include "probdata_dpd.h"
+
+/* presets of the workers; worker k uses presets[k % NPRESETS] and random seed --seed + k */
+static const PortfolioPreset presets[] = {
+        /* name          profile        branching    grasp grasp_freq      lns lns_freq */
+        {"user", NULL, NULL, 0, PORTFOLIO_KEEP, 0, PORTFOLIO_KEEP},
+        {"grasp-heavy", NULL, NULL, 1, 1, 0, PORTFOLIO_KEEP},
+        {"lns-heavy", NULL, NULL, 0, PORTFOLIO_KEEP, 1, 5},
+        {"bound", "tight-bound", "relpscost", 0, PORTFOLIO_KEEP, 0, PORTFOLIO_KEEP},
+        {"fast-primal", "fast-primal", NULL, 1, 1, 1, 10},
+        {"balanced", "balanced", "pscost", 1, 5, 0, PORTFOLIO_KEEP}};
+#define NPRESETS ((int) (sizeof(presets) / sizeof(presets[0])))
+
+typedef struct
+{
+  int id;                        /**< worker id (0 = reports to the standard output) */
+  const PortfolioPreset *preset; /**< configuration of the worker */
+  parametersT param;             /**< user parameters modified by the preset */
+  char *filename;                /**< instance file */
+  Instance *in;                  /**< own copy of the instance (freed by its SCIP); NULL once owned by scip */
+  SCIP *scip;                    /**< SCIP of the worker */
+  SharedIncumbent *shared;       /**< incumbent shared by all workers */
+  const char *incumbentlog;      /**< incumbent log written by this worker (NULL = none) */
+  SCIP_RETCODE retcode;          /**< return code of the worker */
+  SCIP_Bool proved;              /**< did the worker prove optimality (or infeasibility)? */
+} PortfolioWorker;
+
+/** sets the parameters of the worker that are not given by parametersT */
+static SCIP_RETCODE applyPreset(PortfolioWorker *w)
+{
+  char name[SCIP_MAXSTRLEN];
+
+  if (w->id > 0)
+    SCIP_CALL(SCIPsetIntParam(w->scip, "display/verblevel", 0));
+  if (w->preset->branching != NULL)
+  {
+    (void) SCIPsnprintf(name, SCIP_MAXSTRLEN, "branching/%s/priority", w->preset->branching);
+    SCIP_CALL(SCIPsetIntParam(w->scip, name, 2000000));
+  }
+  if (w->param.heur_grasp && w->preset->grasp_freq != PORTFOLIO_KEEP)
+    SCIP_CALL(SCIPsetIntParam(w->scip, "heuristics/grasp/freq", w->preset->grasp_freq));
+  if (w->param.heur_lns && w->preset->lns_freq != PORTFOLIO_KEEP)
+    SCIP_CALL(SCIPsetIntParam(w->scip, "heuristics/lns/freq", w->preset->lns_freq));
+  return SCIP_OKAY;
+}
+
+static SCIP_RETCODE runWorker(PortfolioWorker *w)
+{
+  SCIP_STATUS status;
+
+  if (w->in == NULL && !loadInstance(w->filename, &w->in, w->param.area_penalty))
+  {
+    printf("\nPortfolio worker %d: problem to read instance file %s\n", w->id, w->filename);
+    return SCIP_READERROR;
+  }
+  SCIP_CALL(configScip(&w->scip, &w->param));
+  SCIP_CALL(applyPreset(w));
+  SCIP_CALL(SCIPincludeHeurPortfolio(w->scip, w->shared, w->id));
+  if (w->incumbentlog != NULL)
+    SCIP_CALL(SCIPincludeEventHdlrIncumbent(w->scip, w->incumbentlog));
+  if (!loadProblem(w->scip, w->filename, w->in, 0, NULL))
+  {
+    printf("\nPortfolio worker %d: problem to load instance problem\n", w->id);
+    return SCIP_ERROR;
+  }
+  w->in = NULL;  // the instance now belongs to the SCIP of the worker
+
+  SCIP_CALL(SCIPsolve(w->scip));
+
+  (void) sharedIncumbentPublish(w->scip, w->shared, SCIPgetBestSol(w->scip), w->id);
+  status = SCIPgetStatus(w->scip);
+  if (status == SCIP_STATUS_OPTIMAL || status == SCIP_STATUS_INFEASIBLE)
+  {
+    w->proved = TRUE;
+    pthread_mutex_lock(&w->shared->lock);
+    w->shared->finished = 1;
+    pthread_mutex_unlock(&w->shared->lock);
+  }
+  return SCIP_OKAY;
+}
+
+static void *workerThread(void *arg)
+{
+  PortfolioWorker *w = (PortfolioWorker *) arg;
+
+  w->retcode         = runWorker(w);
+  if (w->retcode != SCIP_OKAY)
+  {
+    printf("\nPortfolio worker %d (%s) failed: retcode=%d\n", w->id, w->preset->name, w->retcode);
+  }
+  return NULL;
+}
+
+/** is the result of worker a better than the result of worker b? */
+static SCIP_Bool isBetterWorker(PortfolioWorker *a, PortfolioWorker *b)
+{
+  SCIP_Real pa, pb;
+
+  if (a->proved != b->proved)
+    return a->proved;
+  pa = SCIPgetPrimalbound(a->scip);
+  pb = SCIPgetPrimalbound(b->scip);
+  if (!SCIPisEQ(a->scip, pa, pb))
+    return SCIPgetObjsense(a->scip) == SCIP_OBJSENSE_MAXIMIZE ? pa > pb : pa < pb;
+  return SCIPgetGap(a->scip) < SCIPgetGap(b->scip);
+}
+
+SCIP *portfolioSolve(char *instance_filename, Instance *in, parametersT param, const char *incumbentlog, double *walltime)
+{
+  PortfolioWorker *workers;
+  pthread_t *threads;
+  SharedIncumbent *shared;
+  struct timespec start, end;
+  SCIP *scip;
+  int nworkers, ncreated, i, best;
+
+  nworkers = param.threads;
+  workers  = (PortfolioWorker *) calloc(nworkers, sizeof(PortfolioWorker));
+  threads  = (pthread_t *) malloc(nworkers * sizeof(pthread_t));
+  shared   = sharedIncumbentCreate(in->nCourses);
+  if (workers == NULL || threads == NULL || shared == NULL)
+  {
+    printf("\nPortfolio: not enough memory\n");
+    free(workers);
+    free(threads);
+    sharedIncumbentFree(&shared);
+    return NULL;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (ncreated = 0, i = 0; i < nworkers; i++)
+  {
+    workers[i].id           = i;
+    workers[i].preset       = &presets[i % NPRESETS];
+    workers[i].param        = param;
+    workers[i].param.seed   = param.seed + i;  // own SCIP seed shift and heuristic streams (set by configScip)
+    workers[i].filename     = instance_filename;
+    workers[i].in           = (i == 0) ? in : NULL;  // worker 0 reuses the instance already loaded
+    workers[i].scip         = NULL;
+    workers[i].shared       = shared;
+    workers[i].incumbentlog = (i == 0) ? incumbentlog : NULL;
+    workers[i].retcode      = SCIP_OKAY;
+    workers[i].proved       = FALSE;
+    if (workers[i].preset->profile != NULL && profileExists(workers[i].preset->profile))
+      strcpy(workers[i].param.profile, workers[i].preset->profile);
+    if (workers[i].preset->grasp)
+      workers[i].param.heur_grasp = 1;
+    if (workers[i].preset->lns)
+      workers[i].param.heur_lns = 1;
+    if (pthread_create(&threads[i], NULL, workerThread, &workers[i]) != 0)
+    {
+      printf("\nPortfolio: could not create thread for worker %d\n", i);
+      workers[i].retcode = SCIP_ERROR;
+      nworkers           = i + 1;
+      break;
+    }
+    ncreated++;
+  }
+  for (i = 0; i < ncreated; i++)
+    pthread_join(threads[i], NULL);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  *walltime = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+  // report the workers and choose the one to be reported
+  best = -1;
+  printf("\nPortfolio (%d workers, wall clock %.2lfs):\n", nworkers, *walltime);
+  for (i = 0; i < nworkers; i++)
+  {
+    if (workers[i].retcode != SCIP_OKAY || workers[i].scip == NULL)
+      continue;
+    printf("  worker %d (%s, profile %s): status %d, primal %lf, dual %lf, injected %lld\n", i, workers[i].preset->name, workers[i].param.profile,
+           SCIPgetStatus(workers[i].scip), SCIPgetPrimalbound(workers[i].scip), SCIPgetDualbound(workers[i].scip),
+           SCIPheurPortfolioGetNInjected(SCIPfindHeur(workers[i].scip, "portfolio")));
+    if (best < 0 || isBetterWorker(&workers[i], &workers[best]))
+      best = i;
+  }
+
+  scip = NULL;
+  if (best >= 0)
+  {
+    printf("Reported worker: %d (%s)\n", best, workers[best].preset->name);
+    scip = workers[best].scip;
+  }
+  for (i = 0; i < nworkers; i++)
+  {
+    if (i == best)
+      continue;
+    if (workers[i].scip != NULL)
+      (void) SCIPfree(&workers[i].scip);
+    if (workers[i].in != NULL && workers[i].in != in)
+      freeInstance(workers[i].in);
+  }
+  free(workers);
+  free(threads);
+  sharedIncumbentFree(&shared);
+  return scip;
+}
@@ -0,0 +1,36 @@
+/**@file   portfolio_dpd.h
+ * @brief  concurrent portfolio solve: several differently configured SCIP instances of the same instance, solved
+ *         in parallel threads and sharing their incumbents (see heur_portfolio.h)
+ **/
+#ifndef __PORTFOLIO_DPD__
+#define __PORTFOLIO_DPD__
+
+#include "parameters_dpd.h"
+#include "problem.h"
+#include "scip/scip.h"
+
+/** worker configuration, applied on top of the user parameters */
+typedef struct
+{
+  const char *name;      /**< name shown in the reports */
+  const char *profile;   /**< SCIP settings profile (NULL = keep the user profile) */
+  const char *branching; /**< branching rule with the highest priority (NULL = keep the profile choice) */
+  int grasp;             /**< 1 = include GRASP even if disabled by the user */
+  int grasp_freq;        /**< GRASP frequency (PORTFOLIO_KEEP = keep) */
+  int lns;               /**< 1 = include LNS even if disabled by the user */
+  int lns_freq;          /**< LNS frequency (PORTFOLIO_KEEP = keep) */
+} PortfolioPreset;
+
+#define PORTFOLIO_KEEP -2 /* keep the value of the user parameters */
+
+/**
+ * solves the instance with param.threads workers in parallel. Each worker uses its own copy of the instance and a
+ * different preset and random seed. Incumbents are exchanged between the workers and the run stops as soon as one
+ * worker proves optimality.
+ * If incumbentlog is not NULL, worker 0 streams its incumbents (which include the ones injected by the other workers)
+ * to this file.
+ * Returns the SCIP of the worker whose result should be reported (the others are freed), or NULL on failure.
+ */
+SCIP *portfolioSolve(char *instance_filename, Instance *in, parametersT param, const char *incumbentlog, double *walltime);
+
+#endif
@@ -45,7 +45,6 @@ static SCIP_RETCODE addCourseAssignmentConstraints(SCIP *scip, SCIP_CONS **conss
                                                    int *ncons, SCIP_VAR **vars, Instance *I);
 static SCIP_RETCODE addWorkloadConstraints(SCIP *scip, SCIP_CONS **conss,
                                            int *ncons, SCIP_VAR **vars, Instance *I);
-static int calculateAptitudeCoefficient(Instance *I, int professor_idx, int course_idx);
 static SCIP_Bool isProfessorEligibleForCourse(Instance *I, int professor_idx, int course_idx);
 
 /**@name Utility functions
@@ -89,7 +88,7 @@ static SCIP_Bool isProfessorEligibleForCourse(Instance *I, int professor_idx, in
 }
 
 /** Calculate aptitude coefficient for professor-course assignment */
-static int calculateAptitudeCoefficient(Instance *I, int professor_idx, int course_idx)
+int calculateAptitudeCoefficient(Instance *I, int professor_idx, int course_idx)
 {
   assert(I != NULL);
   assert(professor_idx >= 0 && professor_idx < I->nProfessors);
@@ -161,6 +160,13 @@ static SCIP_RETCODE probdataCreate(
   /* Initialize constraints array */
   SCIP_CALL(SCIPduplicateMemoryArray(scip, &(*probdata)->conss, conss, ncons));
 
+  /* Map every variable to its position in vars, so heuristics never parse variable names */
+  SCIP_CALL(SCIPhashmapCreate(&(*probdata)->varmap, SCIPblkmem(scip), 2 * nvars + 1));
+  for (int i = 0; i < nvars; ++i)
+  {
+    SCIP_CALL(SCIPhashmapInsertInt((*probdata)->varmap, vars[i], i));
+  }
+
   /* Set problem data fields */
   (*probdata)->I             = I;
   (*probdata)->nvars         = nvars;
@@ -194,6 +200,8 @@ static SCIP_RETCODE probdataFree(
     SCIP_CALL(SCIPreleaseCons(scip, &(*probdata)->conss[i]));
   }
 
+  SCIPhashmapFree(&(*probdata)->varmap);
+
   /* Free memory arrays */
   if ((*probdata)->vars != NULL)
     SCIPfreeMemoryArray(scip, &(*probdata)->vars);
@@ -450,6 +458,12 @@ static SCIP_DECL_PROBTRANS(probtransDPD)
   /* Transform all variables */
   SCIP_CALL(SCIPtransformVars(scip, (*targetdata)->nvars, sourcedata->vars, (*targetdata)->vars));
 
+  /* The map already knows the original variables; add their transformed counterparts */
+  for (int i = 0; i < (*targetdata)->nvars; ++i)
+  {
+    SCIP_CALL(SCIPhashmapInsertInt((*targetdata)->varmap, (*targetdata)->vars[i], i));
+  }
+
   return SCIP_OKAY;
 }
 
@@ -579,4 +593,92 @@ const char *SCIPprobdataGetProbname(
   return probdata->probname;
 }
 
+/** returns the variable x_{professor,course} */
+SCIP_VAR *SCIPprobdataGetVarByIndex(
+        SCIP_PROBDATA *probdata, /**< problem data */
+        int professor,           /**< professor index */
+        int course               /**< course index */
+)
+{
+  assert(probdata != NULL);
+  assert(professor >= 0 && professor < probdata->I->nProfessors);
+  assert(course >= 0 && course < probdata->I->nCourses);
+
+  return probdata->vars[professor * probdata->I->nCourses + course];
+}
+
+/** recovers the (professor, course) pair of a variable in O(1); accepts original and transformed variables */
+SCIP_Bool SCIPprobdataGetVarIndex(
+        SCIP_PROBDATA *probdata, /**< problem data */
+        SCIP_VAR *var,           /**< variable x_{professor,course} */
+        int *professor,          /**< pointer to store the professor index */
+        int *course              /**< pointer to store the course index */
+)
+{
+  int idx;
+
+  assert(probdata != NULL);
+  assert(var != NULL);
+
+  if (!SCIPhashmapExists(probdata->varmap, var))
+    return FALSE;
+
+  idx = SCIPhashmapGetImageInt(probdata->varmap, var);
+  if (professor != NULL)
+    *professor = idx / probdata->I->nCourses;
+  if (course != NULL)
+    *course = idx % probdata->I->nCourses;
+
+  return TRUE;
+}
+
+/** gets the professor assigned to each course in sol; returns FALSE if some course is not assigned */
+SCIP_Bool SCIPprobdataGetAssignment(
+        SCIP *scip,              /**< SCIP data structure */
+        SCIP_PROBDATA *probdata, /**< problem data */
+        SCIP_SOL *sol,           /**< solution */
+        int *assignment          /**< array (one entry per course) to store the professor of each course */
+)
+{
+  int i, j, nCourses;
+
+  assert(probdata != NULL);
+  assert(assignment != NULL);
+
+  nCourses = probdata->I->nCourses;
+  for (j = 0; j < nCourses; j++)
+  {
+    assignment[j] = -1;
+    for (i = 0; i < probdata->I->nProfessors && assignment[j] < 0; i++)
+    {
+      if (SCIPgetSolVal(scip, sol, probdata->vars[i * nCourses + j]) > 0.5)
+        assignment[j] = i;
+    }
+    if (assignment[j] < 0)
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/** sets x_{assignment[course],course} = 1 in sol for each course */
+SCIP_RETCODE SCIPprobdataSetAssignment(
+        SCIP *scip,              /**< SCIP data structure */
+        SCIP_PROBDATA *probdata, /**< problem data */
+        SCIP_SOL *sol,           /**< solution */
+        int *assignment          /**< professor of each course */
+)
+{
+  int j, nCourses;
+
+  assert(probdata != NULL);
+  assert(assignment != NULL);
+
+  nCourses = probdata->I->nCourses;
+  for (j = 0; j < nCourses; j++)
+  {
+    SCIP_CALL(SCIPsetSolVal(scip, sol, SCIPprobdataGetVarByIndex(probdata, assignment[j], j), 1.0));
+  }
+  return SCIP_OKAY;
+}
+
 /**@} */
@@ -57,6 +57,7 @@ struct SCIP_ProbData
   int ncons;               /**< number of constraints */
   Instance *I;             /**< instance of knapsack */
   SCIP_Bool owns_instance; /**< whether this probdata owns the instance and should free it */
+  SCIP_HASHMAP *varmap;    /**< maps each variable (original and transformed) to its index in vars */
 };
 
 /** sets up the problem data */
@@ -103,4 +104,42 @@ extern int SCIPprobdataGetNcons(
 extern Instance *SCIPprobdataGetInstance(
         SCIP_PROBDATA *probdata /**< problem data */
 );
+
+/** returns the variable x_{professor,course} */
+extern SCIP_VAR *SCIPprobdataGetVarByIndex(
+        SCIP_PROBDATA *probdata, /**< problem data */
+        int professor,           /**< professor index */
+        int course               /**< course index */
+);
+
+/** recovers the (professor, course) pair of a variable in O(1); accepts original and transformed variables */
+extern SCIP_Bool SCIPprobdataGetVarIndex(
+        SCIP_PROBDATA *probdata, /**< problem data */
+        SCIP_VAR *var,           /**< variable x_{professor,course} */
+        int *professor,          /**< pointer to store the professor index */
+        int *course              /**< pointer to store the course index */
+);
+
+/** gets the professor assigned to each course in sol; returns FALSE if some course is not assigned */
+extern SCIP_Bool SCIPprobdataGetAssignment(
+        SCIP *scip,              /**< SCIP data structure */
+        SCIP_PROBDATA *probdata, /**< problem data */
+        SCIP_SOL *sol,           /**< solution */
+        int *assignment          /**< array (one entry per course) to store the professor of each course */
+);
+
+/** objective coefficient of x_{professor,course}: preference weight (at least 1) if the areas match, -area penalty otherwise */
+extern int calculateAptitudeCoefficient(
+        Instance *I,       /**< instance */
+        int professor_idx, /**< professor index */
+        int course_idx     /**< course index */
+);
+
+/** sets x_{assignment[course],course} = 1 in sol for each course */
+extern SCIP_RETCODE SCIPprobdataSetAssignment(
+        SCIP *scip,              /**< SCIP data structure */
+        SCIP_PROBDATA *probdata, /**< problem data */
+        SCIP_SOL *sol,           /**< solution */
+        int *assignment          /**< professor of each course */
+);
 #endif
@@ -22,7 +22,6 @@ typedef struct
   Subject subject;  // subject of the course
   int number;       // number of the course
   int workload;     // workload of the course
-  int level;        // level of the Course vertex in the graph based on the number of professors that can teach it
   enum Period
   {
     morning,
@@ -57,10 +56,7 @@ typedef struct
   Preference *preferences;    // array of preferences for the courses
   float avgPreferenceWeight;  // average weight of the preferences
 
-  // Portuguese field names for backward compatibility with GRASP heuristic
-  int current_CH1;  // alias for currentWorkload1
-  int current_CH2;  // alias for currentWorkload2
-  int level;        // alias for numSuitableCourses
+  int level;  // alias for numSuitableCourses
 } Professor;
 
 // Instance structure
@@ -0,0 +1,94 @@
+/**@file   rng_dpd.c
+ * @brief  xoshiro256** random streams with jump-ahead (D. Blackman and S. Vigna, public domain reference code)
+ **/
+#include "rng_dpd.h"
+
+static inline uint64_t rotl(const uint64_t x, int k)
+{
+  return (x << k) | (x >> (64 - k));
+}
+
+/** splitmix64: expands a 64-bit seed into the state of xoshiro256** */
+static uint64_t splitmix64(uint64_t *x)
+{
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+
+  z          = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z          = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+void rngSeed(RngT *rng, uint64_t seed, uint64_t stream)
+{
+  uint64_t x = seed ^ (stream * 0xd1b54a32d192ed03ULL);
+
+  for (int i = 0; i < 4; i++)
+    rng->s[i] = splitmix64(&x);
+}
+
+uint64_t rngNext(RngT *rng)
+{
+  uint64_t *s           = rng->s;
+  const uint64_t result = rotl(s[1] * 5, 7) * 9;
+  const uint64_t t      = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3]  = rotl(s[3], 45);
+  return result;
+}
+
+double rngUniform(RngT *rng)
+{
+  // the 53 high bits give every double of [0, 1) with a step of 2^-53
+  return (double) (rngNext(rng) >> 11) * 0x1.0p-53;
+}
+
+int rngInt(RngT *rng, int low, int high)
+{
+  uint64_t range = (uint64_t) ((int64_t) high - low) + 1;
+
+  return low + (int) (((rngNext(rng) >> 32) * range) >> 32);
+}
+
+/** advances the stream by the polynomial given in jump (the 256 bits of a jump of the reference code) */
+static void rngAdvance(RngT *rng, const uint64_t jump[4])
+{
+  uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+  for (int i = 0; i < 4; i++)
+  {
+    for (int b = 0; b < 64; b++)
+    {
+      if (jump[i] & ((uint64_t) 1 << b))
+      {
+        s0 ^= rng->s[0];
+        s1 ^= rng->s[1];
+        s2 ^= rng->s[2];
+        s3 ^= rng->s[3];
+      }
+      rngNext(rng);
+    }
+  }
+  rng->s[0] = s0;
+  rng->s[1] = s1;
+  rng->s[2] = s2;
+  rng->s[3] = s3;
+}
+
+void rngJump(RngT *rng)
+{
+  static const uint64_t jump[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+
+  rngAdvance(rng, jump);
+}
+
+void rngLongJump(RngT *rng)
+{
+  static const uint64_t jump[4] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+
+  rngAdvance(rng, jump);
+}
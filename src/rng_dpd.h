@@ -0,0 +1,51 @@
+/**@file   rng_dpd.h
+ * @brief  seeded, splittable random number streams (xoshiro256**) for the randomized heuristics
+ *
+ * Every heuristic owns one stream, seeded from --seed and an identifier of the heuristic. Independent sub-streams are
+ * split from it with jumps: rngLongJump advances a stream by 2^192 numbers (one sub-stream per call), rngJump by 2^128
+ * numbers (one sub-stream per thread of a call). A stream is a plain value: copying it copies its state, so threads
+ * never share hidden state and a run with the same seed and the same number of threads draws the same numbers.
+ **/
+#ifndef __RNG_DPD__
+#define __RNG_DPD__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* identifiers of the streams of the heuristics (mixed into the seed) */
+#define RNG_STREAM_GRASP 1
+#define RNG_STREAM_ZOBRIST 2
+
+/** state of a random stream */
+typedef struct
+{
+  uint64_t s[4]; /**< state of xoshiro256** (never all zero) */
+} RngT;
+
+/** seeds the stream of a heuristic from the seed of the run and the identifier of the heuristic */
+void rngSeed(RngT *rng, uint64_t seed, uint64_t stream);
+
+/** next 64 random bits */
+uint64_t rngNext(RngT *rng);
+
+/** uniform real number in [0, 1) */
+double rngUniform(RngT *rng);
+
+/** uniform integer in [low, high] */
+int rngInt(RngT *rng, int low, int high);
+
+/** advances the stream by 2^128 numbers (sub-stream of a thread) */
+void rngJump(RngT *rng);
+
+/** advances the stream by 2^192 numbers (sub-stream of a call) */
+void rngLongJump(RngT *rng);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
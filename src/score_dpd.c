@@ -0,0 +1,58 @@
+/**@file   score_dpd.c
+ * @brief  candidate scoring kernels of the GRASP construction (scalar and AVX2)
+ **/
+#include <math.h>
+
+#include "score_dpd.h"
+
+#ifdef GRASP_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
+void score_kernel_scalar(const double *base, const double *degp, double degt, int count, double *greedy, int *score)
+{
+  double bonust = 1.0 / (1.0 + degt);
+
+  for (int i = 0; i < count; i++)
+  {
+    greedy[i] = base[i] * (1.0 + GRASP_SCORE_K * (1.0 / (1.0 + degp[i]) + bonust));
+    score[i]  = (int) ceil(greedy[i]);
+  }
+}
+
+#ifdef GRASP_HAVE_AVX2
+// same operations in the same order as the scalar kernel (same scores). The tail of the row is scored here too: a call
+// to the scalar kernel would run its SSE code with the upper halves of the registers dirty (compiled as a tail jump,
+// without vzeroupper), which made short rows several times slower than the scalar kernel
+__attribute__((target("avx2"))) void score_kernel_avx2(const double *base, const double *degp, double degt, int count, double *greedy, int *score)
+{
+  const double bt      = 1.0 / (1.0 + degt);
+  const __m256d one    = _mm256_set1_pd(1.0);
+  const __m256d k      = _mm256_set1_pd(GRASP_SCORE_K);
+  const __m256d bonust = _mm256_set1_pd(bt);
+  int i;
+
+  for (i = 0; i + 4 <= count; i += 4)
+  {
+    __m256d inv = _mm256_div_pd(one, _mm256_add_pd(one, _mm256_loadu_pd(degp + i)));
+    __m256d g   = _mm256_mul_pd(_mm256_loadu_pd(base + i), _mm256_add_pd(one, _mm256_mul_pd(k, _mm256_add_pd(inv, bonust))));
+
+    _mm256_storeu_pd(greedy + i, g);
+    _mm_storeu_si128((__m128i *) (score + i), _mm256_cvtpd_epi32(_mm256_ceil_pd(g)));
+  }
+  for (; i < count; i++)
+  {
+    greedy[i] = base[i] * (1.0 + GRASP_SCORE_K * (1.0 / (1.0 + degp[i]) + bt));
+    score[i]  = (int) ceil(greedy[i]);
+  }
+}
+#endif
+
+ScoreKernelT score_kernel_select(void)
+{
+#ifdef GRASP_HAVE_AVX2
+  if (__builtin_cpu_supports("avx2"))
+    return score_kernel_avx2;
+#endif
+  return score_kernel_scalar;
+}
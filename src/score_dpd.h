@@ -0,0 +1,42 @@
+/**@file   score_dpd.h
+ * @brief  candidate scoring kernels of the GRASP construction (scalar and AVX2)
+ *
+ * The greedy score of a professor p for a course t is base * (1 + GRASP_SCORE_K * (1 / (1 + degree of p) + 1 / (1 +
+ * degree of t))), and its integer score is the ceiling of it. A kernel scores the whole row of candidates of a course
+ * at once. The AVX2 kernel performs the same operations in the same order as the scalar one, so both give the same
+ * scores; score_kernel_select picks the AVX2 kernel at run time if the CPU has it. The kernels do not depend on SCIP, so
+ * the benchmark in bench_score.c links them alone.
+ **/
+#ifndef __SCORE_DPD__
+#define __SCORE_DPD__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GRASP_HAVE_AVX2 1 /* the AVX2 scoring kernel is compiled and selected at run time if the CPU has AVX2 */
+#endif
+
+#define GRASP_SCORE_K 5.0 /**< weight factor to amplify the inverse-degree effect */
+
+/** scoring kernel: greedy score and its ceiling for count candidates of a course with degree degt */
+typedef void (*ScoreKernelT)(const double *base, const double *degp, double degt, int count, double *greedy, int *score);
+
+/** scalar scoring kernel (reference; used when the CPU has no AVX2) */
+void score_kernel_scalar(const double *base, const double *degp, double degt, int count, double *greedy, int *score);
+
+#ifdef GRASP_HAVE_AVX2
+/** AVX2 scoring kernel: 4 candidates per instruction (call it only if the CPU has AVX2) */
+void score_kernel_avx2(const double *base, const double *degp, double degt, int count, double *greedy, int *score);
+#endif
+
+/** scoring kernel for this CPU */
+ScoreKernelT score_kernel_select(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
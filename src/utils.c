@@ -7,8 +7,6 @@
 #include <sys/stat.h>
 #include <time.h>
 
-int mCourses = 0;
-
 int comparePreferences(const void *a, const void *b)
 {
   Preference *prefA = (Preference *) a;
@@ -26,9 +24,6 @@ int compareProfessors(const void *a, const void *b)
   Professor *profA = (Professor *) a;
   Professor *profB = (Professor *) b;
 
-  // sort preferences in descending order
-  qsort(profA->preferences, mCourses, sizeof(Preference), comparePreferences);
-
   if (profA->avgPreferenceWeight < profB->avgPreferenceWeight)
     return 1;
   if (profA->avgPreferenceWeight > profB->avgPreferenceWeight)
@@ -44,9 +39,6 @@ int compareCandidates(const void *a, const void *b)
   Professor *profA     = (Professor *) candA->professor_ptr;
   Professor *profB     = (Professor *) candB->professor_ptr;
 
-  // sort preferences in descending order (default behavior - maior para menor)
-  qsort(profA->preferences, mCourses, sizeof(Preference), comparePreferences);
-
   if (profA->avgPreferenceWeight > profB->avgPreferenceWeight)
     return -1;  // Changed from 1 to -1 for descending order
   if (profA->avgPreferenceWeight < profB->avgPreferenceWeight)
@@ -62,9 +54,6 @@ int compareCandidatesAscending(const void *a, const void *b)
   Professor *profA     = (Professor *) candA->professor_ptr;
   Professor *profB     = (Professor *) candB->professor_ptr;
 
-  // sort preferences in ascending order (menor para maior)
-  qsort(profA->preferences, mCourses, sizeof(Preference), comparePreferences);
-
   if (profA->avgPreferenceWeight < profB->avgPreferenceWeight)
     return -1;
   if (profA->avgPreferenceWeight > profB->avgPreferenceWeight)
@@ -72,7 +61,7 @@ int compareCandidatesAscending(const void *a, const void *b)
   return 0;
 }
 
-void printOrderedProfessors(Professor *P, int nProfessors)
+void printOrderedProfessors(Professor *P, int nProfessors, int nCourses)
 {
   printf("-------------------------\n");
   // print professors ordered by avgPreferenceWeight
@@ -80,7 +69,7 @@ void printOrderedProfessors(Professor *P, int nProfessors)
   {
     printf("%s: avgPreferenceWeight=%.2f\n", P[i].name, P[i].avgPreferenceWeight);
     // print preferences
-    for (int j = 0; j < mCourses; j++)
+    for (int j = 0; j < nCourses; j++)
     {
       if (P[i].preferences[j].weight >= EPSILON)
         printf("Professor %s eligible for course %d with weight %f\n", P[i].name, P[i].preferences[j].course_ptr->label, P[i].preferences[j].weight);
@@ -3,12 +3,10 @@
 
 #include "heur_problem.h"
 
-extern int mCourses;
-
 int comparePreferences(const void *a, const void *b);
 int compareProfessors(const void *a, const void *b);
 int compareCandidates(const void *a, const void *b);
 int compareCandidatesAscending(const void *a, const void *b);
-void printOrderedProfessors(Professor *P, int nProfessors);
+void printOrderedProfessors(Professor *P, int nProfessors, int nCourses);
 
 #endif  // UTILS_H
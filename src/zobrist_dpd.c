@@ -0,0 +1,85 @@
+/**@file   zobrist_dpd.c
+ * @brief  Zobrist hashing of assignments and the set of recently evaluated assignments
+ **/
+#include <stdlib.h>
+
+#include "rng_dpd.h"
+#include "zobrist_dpd.h"
+
+ZobristT *zobristCreate(int n, int m, uint64_t seed)
+{
+  ZobristT *zobrist;
+  RngT rng;
+
+  zobrist = (ZobristT *) malloc(sizeof(ZobristT));
+  if (zobrist == NULL)
+    return NULL;
+  zobrist->n    = n;
+  zobrist->m    = m;
+  zobrist->keys = (uint64_t *) malloc(sizeof(uint64_t) * n * m);
+  if (zobrist->keys == NULL)
+  {
+    free(zobrist);
+    return NULL;
+  }
+  // the keys have their own stream, so they do not change the random choices of the heuristics
+  rngSeed(&rng, seed, RNG_STREAM_ZOBRIST);
+  for (int i = 0; i < n * m; i++)
+    zobrist->keys[i] = rngNext(&rng);
+  return zobrist;
+}
+
+void zobristFree(ZobristT **pzobrist)
+{
+  if (*pzobrist == NULL)
+    return;
+  free((*pzobrist)->keys);
+  free(*pzobrist);
+  *pzobrist = NULL;
+}
+
+uint64_t zobristHash(const ZobristT *zobrist, const int *assign)
+{
+  uint64_t hash = 0;
+
+  for (int c = 0; c < zobrist->m; c++)
+    hash ^= zobrist->keys[assign[c] * zobrist->m + c];
+  return hash;
+}
+
+RecentSetT *recentCreate(int log2size)
+{
+  RecentSetT *set;
+
+  set = (RecentSetT *) malloc(sizeof(RecentSetT));
+  if (set == NULL)
+    return NULL;
+  set->mask = ((uint64_t) 1 << log2size) - 1;
+  set->slot = (uint64_t *) calloc(set->mask + 1, sizeof(uint64_t));
+  if (set->slot == NULL)
+  {
+    free(set);
+    return NULL;
+  }
+  return set;
+}
+
+void recentFree(RecentSetT **pset)
+{
+  if (*pset == NULL)
+    return;
+  free((*pset)->slot);
+  free(*pset);
+  *pset = NULL;
+}
+
+int recentContains(const RecentSetT *set, uint64_t hash)
+{
+  // the slot comes from the high bits; the lowest bit is set so that a stored hash is never 0 (empty)
+  return set->slot[(hash >> 32) & set->mask] == (hash | 1);
+}
+
+void recentInsert(RecentSetT *set, uint64_t hash)
+{
+  set->slot[(hash >> 32) & set->mask] = hash | 1;
+}
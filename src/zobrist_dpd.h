@@ -0,0 +1,68 @@
+/**@file   zobrist_dpd.h
+ * @brief  Zobrist hashing of assignments (professor of each course) and a set of recently evaluated assignments
+ *
+ * Each pair (professor p, course c) gets a random 64-bit key; the hash of an assignment is the XOR of the keys of its
+ * pairs. Moving course c from professor p to q changes the hash by keys[p][c] ^ keys[q][c], so the hash is kept up to
+ * date in O(1) per move (see zobristMove). The heuristics use it to skip assignments they already sent to SCIP.
+ *
+ * The set of recent assignments is a direct-mapped table of hashes: a new hash overwrites the one in its slot, so the
+ * set keeps the most recent assignments and never grows. Two different assignments with the same 64-bit hash are
+ * taken as equal (a missed candidate, never a wrong solution).
+ **/
+#ifndef __ZOBRIST_DPD__
+#define __ZOBRIST_DPD__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** keys of the pairs (professor, course) */
+typedef struct
+{
+  uint64_t *keys; /**< key of x_p_c, at p * m + c */
+  int n;          /**< number of professors */
+  int m;          /**< number of courses */
+} ZobristT;
+
+/** set of recently evaluated assignments, given by their hashes */
+typedef struct
+{
+  uint64_t *slot; /**< hash stored in each slot (with the lowest bit set; 0 = empty) */
+  uint64_t mask;  /**< number of slots - 1 (the number of slots is a power of 2) */
+} RecentSetT;
+
+/** creates the keys for n professors and m courses from the seed of the run; returns NULL if there is no memory */
+ZobristT *zobristCreate(int n, int m, uint64_t seed);
+
+/** frees the keys */
+void zobristFree(ZobristT **pzobrist);
+
+/** hash of a complete assignment (professor of each course) */
+uint64_t zobristHash(const ZobristT *zobrist, const int *assign);
+
+/** hash after moving course c from professor from to professor to */
+static inline uint64_t zobristMove(const ZobristT *zobrist, uint64_t hash, int c, int from, int to)
+{
+  return hash ^ zobrist->keys[from * zobrist->m + c] ^ zobrist->keys[to * zobrist->m + c];
+}
+
+/** creates an empty set with 2^log2size slots; returns NULL if there is no memory */
+RecentSetT *recentCreate(int log2size);
+
+/** frees the set */
+void recentFree(RecentSetT **pset);
+
+/** 1 if the assignment with the given hash is in the set */
+int recentContains(const RecentSetT *set, uint64_t hash);
+
+/** adds the assignment with the given hash (replaces the hash in its slot) */
+void recentInsert(RecentSetT *set, uint64_t hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif